@@ -0,0 +1,85 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Walker/Vose alias table: weighted random choice among N columns in O(1).
+ *
+ * Build is O(N) and allocates; Sample is one random column plus one coin flip and
+ * touches no heap, so callers rebuild only when the weights actually change.
+ */
+struct FAliasTable
+{
+	TArray<float> Probability;  // Chance of keeping the column itself, otherwise take Alias
+	TArray<int32> Alias;
+
+	int32 Num() const { return Probability.Num(); }
+
+	void Reset()
+	{
+		Probability.Reset();
+		Alias.Reset();
+	}
+
+	// Weights need not be normalized; an all-zero (or empty) set leaves the table empty
+	void Build(TConstArrayView<float> Weights)
+	{
+		Reset();
+
+		float TotalWeight = 0.0f;
+		for (float Weight : Weights)
+		{
+			TotalWeight += FMath::Max(Weight, 0.0f);
+		}
+
+		const int32 NumColumns = Weights.Num();
+		if (NumColumns == 0 || TotalWeight <= 0.0f)
+		{
+			return;
+		}
+
+		Probability.SetNumUninitialized(NumColumns);
+		Alias.SetNumUninitialized(NumColumns);
+
+		// Scale so the average column is exactly 1, then pair each short column with a tall one
+		TArray<int32, TInlineAllocator<32>> Small;
+		TArray<int32, TInlineAllocator<32>> Large;
+		for (int32 i = 0; i < NumColumns; ++i)
+		{
+			Probability[i] = FMath::Max(Weights[i], 0.0f) * NumColumns / TotalWeight;
+			Alias[i] = i;
+			(Probability[i] < 1.0f ? Small : Large).Add(i);
+		}
+
+		while (Small.Num() > 0 && Large.Num() > 0)
+		{
+			const int32 Short = Small.Pop(EAllowShrinking::No);
+			const int32 Tall = Large.Pop(EAllowShrinking::No);
+			Alias[Short] = Tall;
+			Probability[Tall] += Probability[Short] - 1.0f;
+			(Probability[Tall] < 1.0f ? Small : Large).Add(Tall);
+		}
+
+		// Leftovers are 1 up to float error
+		for (int32 Column : Large)
+		{
+			Probability[Column] = 1.0f;
+		}
+		for (int32 Column : Small)
+		{
+			Probability[Column] = 1.0f;
+		}
+	}
+
+	// Column index, or INDEX_NONE if the table is empty
+	int32 Sample() const
+	{
+		if (Probability.Num() == 0)
+		{
+			return INDEX_NONE;
+		}
+
+		const int32 Column = FMath::RandHelper(Probability.Num());
+		return FMath::FRand() < Probability[Column] ? Column : Alias[Column];
+	}
+};
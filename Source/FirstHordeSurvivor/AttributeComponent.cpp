@@ -164,6 +164,64 @@ float UAttributeComponent::GetDamageResistPercent() const
 }
 
 float UAttributeComponent::ApplyArmoredDamage(float IncomingDamage, AActor* DamageSource)
+{
+	const float FinalDamage = ComputeArmoredDamage(IncomingDamage, DamageSource);
+	if (FinalDamage > 0.0f)
+	{
+		ApplyHealthChange(-FinalDamage);
+	}
+	return FinalDamage;
+}
+
+float UAttributeComponent::ApplyArmoredDamageBatch(TConstArrayView<FArmoredHit> Hits)
+{
+	float TotalDamage = 0.0f;
+	for (const FArmoredHit& Hit : Hits)
+	{
+		TotalDamage += ComputeArmoredDamage(Hit.Damage, Hit.Source);
+	}
+
+	// One health change (and one OnHealthChanged broadcast) for the whole batch
+	if (TotalDamage > 0.0f)
+	{
+		ApplyHealthChange(-TotalDamage);
+	}
+	return TotalDamage;
+}
+
+int32 UAttributeComponent::ApplyHealthChangeBatch(TConstArrayView<UAttributeComponent*> Components, float Delta)
+{
+	// Pass 1: health only. Only components whose health actually moved are collected for the broadcast pass.
+	TArray<UAttributeComponent*, TInlineAllocator<64>> Changed;
+	for (UAttributeComponent* Component : Components)
+	{
+		if (!Component)
+		{
+			continue;
+		}
+
+		const float OldHealth = Component->CurrentHealth;
+		Component->CurrentHealth = FMath::Clamp(OldHealth + Delta, 0.0f, Component->MaxHealth.GetCurrentValue());
+		if (Component->CurrentHealth != OldHealth)
+		{
+			Changed.Add(Component);
+		}
+	}
+
+	// Pass 2: same broadcasts as ApplyHealthChange
+	for (UAttributeComponent* Component : Changed)
+	{
+		Component->OnHealthChanged.Broadcast(Component, false);
+		if (Component->CurrentHealth <= 0.0f)
+		{
+			Component->OnDeath.Broadcast(Component, false);
+		}
+	}
+
+	return Changed.Num();
+}
+
+float UAttributeComponent::ComputeArmoredDamage(float IncomingDamage, AActor* DamageSource)
 {
 	if (IncomingDamage <= 0.0f)
 	{
@@ -203,8 +261,5 @@ float UAttributeComponent::ApplyArmoredDamage(float IncomingDamage, AActor* Dama
 		FinalDamage = 1.0f;
 	}
 
-	// Apply the damage
-	ApplyHealthChange(-FinalDamage);
-
 	return FinalDamage;
 }
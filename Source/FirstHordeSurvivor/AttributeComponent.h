@@ -41,6 +41,13 @@ public:
 	}
 };
 
+// One incoming hit for UAttributeComponent::ApplyArmoredDamageBatch
+struct FArmoredHit
+{
+	float Damage;
+	AActor* Source;
+};
+
 UCLASS( ClassGroup=(Custom), meta=(BlueprintSpawnableComponent) )
 class FIRSTHORDESURVIVOR_API UAttributeComponent : public UActorComponent
 {
@@ -106,6 +113,16 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Attributes")
 	float ApplyArmoredDamage(float IncomingDamage, AActor* DamageSource = nullptr);
 
+	// Apply several hits at once (e.g. every enemy in contact this frame).
+	// Armor, resist and per-source i-frames apply to each hit; health changes once by the total.
+	// Returns the total damage dealt after armor
+	float ApplyArmoredDamageBatch(TConstArrayView<FArmoredHit> Hits);
+
+	// ApplyHealthChange on many components at once (e.g. every enemy in an explosion).
+	// All health values change first, then OnHealthChanged/OnDeath fire, so death handlers
+	// never run while some targets are still undamaged. Returns how many health values changed.
+	static int32 ApplyHealthChangeBatch(TConstArrayView<UAttributeComponent*> Components, float Delta);
+
 	// Delegate fired when any attribute is modified via the setter functions
 	UPROPERTY(BlueprintAssignable, Category = "Attributes")
 	FOnAttributeChanged OnAttributeChanged;
@@ -165,6 +182,9 @@ public:
 	float InvulnerabilityDuration = 0.5f;
 
 protected:
+	// Armor/resist/i-frame reduction for one hit (records the source's i-frame); does not touch health
+	float ComputeArmoredDamage(float IncomingDamage, AActor* DamageSource);
+
 	// Maps each damage source to the world time when its i-frame expires
 	TMap<TWeakObjectPtr<AActor>, double> PerSourceIFrameExpiry;
 };
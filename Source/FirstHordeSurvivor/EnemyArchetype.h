@@ -0,0 +1,64 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "EnemyData.h"
+#include "EnemyTuning.h"
+#include "EnemyArchetype.generated.h"
+
+class UStaticMesh;
+class UMaterialInterface;
+
+/**
+ * One enemy type compiled from its DT_Enemies row.
+ *
+ * Built by UEnemySpawnSubsystem when the tables are configured (and again when a table
+ * changes), stored densely and referenced by a small integer index. Spawning reads
+ * everything from here instead of doing a FindRow and re-deriving stats per enemy.
+ */
+USTRUCT()
+struct FEnemyArchetype
+{
+	GENERATED_BODY()
+
+	FName RowName;
+
+	// Source row; valid until the next rebuild (ASurvivorEnemy::EnemyData is re-pointed then)
+	const FEnemyTableRow* Row = nullptr;
+
+	// Visuals. Mesh/material are filled in once the streamed assets are resident.
+	UPROPERTY()
+	UStaticMesh* Mesh = nullptr;
+
+	// Material as authored (used by instance batches)
+	UPROPERTY()
+	UMaterialInterface* BaseMaterial = nullptr;
+
+	// Shared per-type material for EnemyMeshComp (UHordeRenderSubsystem::GetSharedEnemyMaterial)
+	UPROPERTY()
+	UMaterialInterface* SharedMaterial = nullptr;
+
+	bool bAssetsResolved = false;
+
+	float MeshScale = 1.0f;
+	FLinearColor Color = FLinearColor::White;
+	float EmissiveStrength = 0.0f;
+
+	// Stats
+	float MaxHealth = 100.0f;
+	float MoveSpeed = 400.0f;
+	float BaseDamage = 10.0f;
+	float KnockbackMass = 100.0f;
+	float KnockbackResistance = 1.0f;
+
+	// Rewards
+	int32 MinXP = 0;
+	int32 MaxXP = 0;
+
+	// Gems per GemSettings::Tiers entry for every XP value in [MinXP, MaxXP]
+	TArray<uint16> GemCounts;
+
+	const uint16* GetGemCounts(int32 XP) const
+	{
+		return GemCounts.GetData() + (FMath::Clamp(XP, MinXP, MaxXP) - MinXP) * GemSettings::NumTiers;
+	}
+};
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Cheap, copyable reference to an active enemy, resolved by UEnemySpawnSubsystem::ResolveEnemy.
+ *
+ * Index is the enemy's stable pool slot. The slot's generation advances every time the
+ * enemy is activated or returned to the pool, so a handle kept past the enemy's death
+ * goes stale instead of silently pointing at the recycled actor.
+ */
+struct FEnemyHandle
+{
+	int32 Index = INDEX_NONE;
+	uint32 Generation = 0;
+
+	bool IsSet() const { return Index != INDEX_NONE; }
+
+	bool operator==(const FEnemyHandle& Other) const { return Index == Other.Index && Generation == Other.Generation; }
+	bool operator!=(const FEnemyHandle& Other) const { return !(*this == Other); }
+
+	friend uint32 GetTypeHash(const FEnemyHandle& Handle)
+	{
+		return HashCombineFast(::GetTypeHash(Handle.Index), ::GetTypeHash(Handle.Generation));
+	}
+};
@@ -0,0 +1,152 @@
+#include "EnemySpatialGridSubsystem.h"
+#include "SurvivorEnemy.h"
+#include "Engine/World.h"
+
+namespace SpatialGridSettings
+{
+	// Smallest bucket table we bother with (keeps the mask sane for tiny hordes)
+	constexpr int32 MinBuckets = 64;
+}
+
+void UEnemySpatialGridSubsystem::Deinitialize()
+{
+	Enemies.Empty();
+	Attributes.Empty();
+	Handles.Empty();
+	SortedX.Empty();
+	SortedY.Empty();
+	SortedItems.Empty();
+	SortedCells.Empty();
+	BucketStart.Empty();
+	ItemBuckets.Empty();
+	WriteCursor.Empty();
+
+	Super::Deinitialize();
+}
+
+bool UEnemySpatialGridSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	// Only create for game worlds, not editor preview
+	UWorld* World = Cast<UWorld>(Outer);
+	return World && World->IsGameWorld();
+}
+
+void UEnemySpatialGridSubsystem::Rebuild(TConstArrayView<ASurvivorEnemy*> InEnemies, TConstArrayView<FVector> InPositions, TConstArrayView<FEnemyHandle> InHandles)
+{
+	check(InEnemies.Num() == InPositions.Num() && InEnemies.Num() == InHandles.Num());
+
+	const int32 Count = InEnemies.Num();
+	InvCellSize = 1.0f / FMath::Max(CellSize, 1.0f);
+
+	Enemies.Reset();
+	Enemies.Append(InEnemies.GetData(), Count);
+
+	Handles.Reset();
+	Handles.Append(InHandles.GetData(), Count);
+
+	Attributes.SetNumUninitialized(Count, EAllowShrinking::No);
+	for (int32 Item = 0; Item < Count; ++Item)
+	{
+		Attributes[Item] = Enemies[Item]->AttributeComp;
+	}
+
+	// ~2 buckets per item keeps collision chains short
+	const int32 NumBuckets = FMath::RoundUpToPowerOfTwo(FMath::Max(Count * 2, SpatialGridSettings::MinBuckets));
+	BucketMask = uint32(NumBuckets - 1);
+
+	BucketStart.SetNumUninitialized(NumBuckets + 1, EAllowShrinking::No);
+	FMemory::Memzero(BucketStart.GetData(), BucketStart.Num() * sizeof(int32));
+
+	ItemBuckets.SetNumUninitialized(Count, EAllowShrinking::No);
+	SortedX.SetNumUninitialized(Count, EAllowShrinking::No);
+	SortedY.SetNumUninitialized(Count, EAllowShrinking::No);
+	SortedItems.SetNumUninitialized(Count, EAllowShrinking::No);
+	SortedCells.SetNumUninitialized(Count, EAllowShrinking::No);
+
+	// Pass 1: histogram of bucket sizes (offset by one so the prefix sum yields start indices)
+	for (int32 Item = 0; Item < Count; ++Item)
+	{
+		const FVector2f Position = ToGridPosition(InPositions[Item]);
+		const uint32 Bucket = HashCell(ToCell(Position.X), ToCell(Position.Y)) & BucketMask;
+		ItemBuckets[Item] = Bucket;
+		++BucketStart[Bucket + 1];
+	}
+
+	for (int32 Bucket = 0; Bucket < NumBuckets; ++Bucket)
+	{
+		BucketStart[Bucket + 1] += BucketStart[Bucket];
+	}
+
+	// Pass 2: scatter into packed arrays
+	WriteCursor.SetNumUninitialized(NumBuckets, EAllowShrinking::No);
+	FMemory::Memcpy(WriteCursor.GetData(), BucketStart.GetData(), NumBuckets * sizeof(int32));
+
+	for (int32 Item = 0; Item < Count; ++Item)
+	{
+		const FVector2f Position = ToGridPosition(InPositions[Item]);
+		const int32 Entry = WriteCursor[ItemBuckets[Item]]++;
+		SortedX[Entry] = Position.X;
+		SortedY[Entry] = Position.Y;
+		SortedItems[Entry] = Item;
+		SortedCells[Entry] = PackCell(ToCell(Position.X), ToCell(Position.Y));
+	}
+}
+
+void UEnemySpatialGridSubsystem::QueryRadius(const FVector& Center, float Radius, TArray<ASurvivorEnemy*>& OutEnemies, const ASurvivorEnemy* IgnoreEnemy) const
+{
+	OutEnemies.Reset();
+
+	ForEachInRadius(ToGridPosition(Center), Radius, [&](int32 ItemIndex, const FVector2f& ItemPosition, float DistSq)
+	{
+		ASurvivorEnemy* Enemy = Enemies[ItemIndex];
+		if (Enemy != IgnoreEnemy)
+		{
+			OutEnemies.Add(Enemy);
+		}
+	});
+}
+
+void UEnemySpatialGridSubsystem::QueryKNearest(const FVector& Center, int32 K, float MaxRadius, TArray<ASurvivorEnemy*>& OutEnemies, const ASurvivorEnemy* IgnoreEnemy) const
+{
+	OutEnemies.Reset();
+	if (K <= 0)
+	{
+		return;
+	}
+
+	struct FCandidate
+	{
+		float DistSq;
+		int32 ItemIndex;
+	};
+
+	// Bounded max-heap of the K closest so far: the root is the farthest kept candidate
+	TArray<FCandidate, TInlineAllocator<16>> Heap;
+	auto FartherFirst = [](const FCandidate& A, const FCandidate& B) { return A.DistSq > B.DistSq; };
+
+	ForEachInRadius(ToGridPosition(Center), MaxRadius, [&](int32 ItemIndex, const FVector2f& ItemPosition, float DistSq)
+	{
+		if (Enemies[ItemIndex] == IgnoreEnemy)
+		{
+			return;
+		}
+
+		if (Heap.Num() < K)
+		{
+			Heap.HeapPush({ DistSq, ItemIndex }, FartherFirst);
+		}
+		else if (DistSq < Heap.HeapTop().DistSq)
+		{
+			Heap.HeapPopDiscard(FartherFirst, EAllowShrinking::No);
+			Heap.HeapPush({ DistSq, ItemIndex }, FartherFirst);
+		}
+	});
+
+	Heap.Sort([](const FCandidate& A, const FCandidate& B) { return A.DistSq < B.DistSq; });
+
+	OutEnemies.Reserve(Heap.Num());
+	for (const FCandidate& Candidate : Heap)
+	{
+		OutEnemies.Add(Enemies[Candidate.ItemIndex]);
+	}
+}
@@ -0,0 +1,141 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "EnemyHandle.h"
+#include "EnemySpatialGridSubsystem.generated.h"
+
+class ASurvivorEnemy;
+class UAttributeComponent;
+
+/**
+ * WorldSubsystem that buckets active enemies into a uniform hash grid once per frame.
+ * Replaces per-enemy physics overlap queries with walks over packed arrays.
+ * Rebuilt by UHordeSimulationSubsystem at the start of each horde step.
+ *
+ * Entries are counting-sorted by cell hash, so every cell's enemies sit contiguously
+ * in SortedX/SortedY. A query only touches the buckets of the cells it overlaps.
+ * All queries are 2D (XY) — enemies live on a flat floor.
+ */
+UCLASS()
+class FIRSTHORDESURVIVOR_API UEnemySpatialGridSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// USubsystem interface
+	virtual void Deinitialize() override;
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+
+	// Rebuild from explicit enemy/position/handle triples. Item indices in queries match the input order.
+	void Rebuild(TConstArrayView<ASurvivorEnemy*> InEnemies, TConstArrayView<FVector> InPositions, TConstArrayView<FEnemyHandle> InHandles);
+
+	// Collect every enemy within Radius of Center (unordered)
+	void QueryRadius(const FVector& Center, float Radius, TArray<ASurvivorEnemy*>& OutEnemies, const ASurvivorEnemy* IgnoreEnemy = nullptr) const;
+
+	// Collect up to K enemies within MaxRadius of Center, sorted nearest-first
+	void QueryKNearest(const FVector& Center, int32 K, float MaxRadius, TArray<ASurvivorEnemy*>& OutEnemies, const ASurvivorEnemy* IgnoreEnemy = nullptr) const;
+
+	/**
+	 * Visit every item within Radius of Center without allocating.
+	 * Func signature: void(int32 ItemIndex, const FVector2f& ItemPosition, float DistSq)
+	 */
+	template<typename FuncType>
+	void ForEachInRadius(const FVector2f& Center, float Radius, FuncType&& Func) const;
+
+	ASurvivorEnemy* GetEnemy(int32 ItemIndex) const { return Enemies[ItemIndex]; }
+
+	// The item's attribute component, cached at rebuild (no component lookup per damage query)
+	UAttributeComponent* GetAttributes(int32 ItemIndex) const { return Attributes[ItemIndex]; }
+
+	// The item's handle at rebuild. An enemy that died (and maybe respawned elsewhere) since then
+	// no longer matches UEnemySpawnSubsystem::GetEnemyHandle, so its grid entry must be skipped.
+	FEnemyHandle GetHandle(int32 ItemIndex) const { return Handles[ItemIndex]; }
+	int32 GetNumItems() const { return Enemies.Num(); }
+
+	static FVector2f ToGridPosition(const FVector& Location) { return FVector2f((float)Location.X, (float)Location.Y); }
+
+	// Cell edge length. Matches the separation radius so a separation query touches at most 3x3 cells.
+	UPROPERTY(EditAnywhere, Category = "Grid")
+	float CellSize = 150.0f;
+
+protected:
+	static uint64 PackCell(int32 CellX, int32 CellY) { return (uint64(uint32(CellX)) << 32) | uint64(uint32(CellY)); }
+	static uint32 HashCell(int32 CellX, int32 CellY) { return (uint32(CellX) * 73856093u) ^ (uint32(CellY) * 19349663u); }
+	int32 ToCell(float Coord) const { return FMath::FloorToInt32(Coord * InvCellSize); }
+
+	// Source items, indexed by item index. Raw pointers: only valid for the frame the grid was built.
+	TArray<ASurvivorEnemy*> Enemies;
+	TArray<UAttributeComponent*> Attributes;  // Parallel to Enemies
+	TArray<FEnemyHandle> Handles;             // Parallel to Enemies
+
+	// Packed entries, sorted by bucket (counting sort)
+	TArray<float> SortedX;
+	TArray<float> SortedY;
+	TArray<int32> SortedItems;
+	TArray<uint64> SortedCells;  // Distinguishes cells that collide into the same bucket
+
+	// SortedX[BucketStart[B] .. BucketStart[B + 1]) are the entries of bucket B
+	TArray<int32> BucketStart;
+	uint32 BucketMask = 0;
+
+	// Per-item scratch reused between rebuilds
+	TArray<uint32> ItemBuckets;
+	TArray<int32> WriteCursor;
+
+	float InvCellSize = 1.0f / 150.0f;
+};
+
+template<typename FuncType>
+void UEnemySpatialGridSubsystem::ForEachInRadius(const FVector2f& Center, float Radius, FuncType&& Func) const
+{
+	if (SortedItems.Num() == 0)
+	{
+		return;
+	}
+
+	const float RadiusSq = Radius * Radius;
+
+	auto VisitEntry = [&](int32 Entry)
+	{
+		const FVector2f ItemPosition(SortedX[Entry], SortedY[Entry]);
+		const float DistSq = FVector2f::DistSquared(ItemPosition, Center);
+		if (DistSq <= RadiusSq)
+		{
+			Func(SortedItems[Entry], ItemPosition, DistSq);
+		}
+	};
+
+	const int32 MinX = ToCell(Center.X - Radius);
+	const int32 MaxX = ToCell(Center.X + Radius);
+	const int32 MinY = ToCell(Center.Y - Radius);
+	const int32 MaxY = ToCell(Center.Y + Radius);
+
+	// Huge queries (e.g. weapon range) cover more cells than there are buckets — a flat scan is cheaper
+	const int64 NumCells = int64(MaxX - MinX + 1) * int64(MaxY - MinY + 1);
+	if (NumCells >= int64(BucketMask) + 1)
+	{
+		for (int32 Entry = 0; Entry < SortedItems.Num(); ++Entry)
+		{
+			VisitEntry(Entry);
+		}
+		return;
+	}
+
+	for (int32 CellY = MinY; CellY <= MaxY; ++CellY)
+	{
+		for (int32 CellX = MinX; CellX <= MaxX; ++CellX)
+		{
+			const uint64 CellKey = PackCell(CellX, CellY);
+			const uint32 Bucket = HashCell(CellX, CellY) & BucketMask;
+			const int32 End = BucketStart[Bucket + 1];
+			for (int32 Entry = BucketStart[Bucket]; Entry < End; ++Entry)
+			{
+				if (SortedCells[Entry] == CellKey)
+				{
+					VisitEntry(Entry);
+				}
+			}
+		}
+	}
+}
@@ -1,5 +1,7 @@
 #include "EnemySpawnSubsystem.h"
 #include "SurvivorEnemy.h"
+#include "EnemyData.h"
+#include "HordeRenderSubsystem.h"
 #include "Kismet/GameplayStatics.h"
 #include "GameFramework/Character.h"
 #include "Engine/World.h"
@@ -7,6 +9,9 @@
 #include "Engine/Engine.h"
 #include "TimerManager.h"
 #include "EngineUtils.h"
+#include "HAL/PlatformTime.h"
+#include "Algo/Unique.h"
+#include "Algo/UpperBound.h"
 
 void UEnemySpawnSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 {
@@ -33,6 +38,28 @@ void UEnemySpawnSubsystem::Deinitialize()
 	// Clear pools (actors will be cleaned up by world)
 	EnemyPool.Empty();
 	ActiveEnemies.Empty();
+	PendingDeaths.Empty();
+	GemRequests.Empty();
+	SlotEnemies.Empty();
+	SlotGenerations.Empty();
+
+	for (const TPair<int32, TSharedPtr<FStreamableHandle>>& Pair : EnemyAssetHandles)
+	{
+		if (Pair.Value.IsValid())
+		{
+			Pair.Value->ReleaseHandle();
+		}
+	}
+	EnemyAssetHandles.Empty();
+
+	UnwatchTables();
+	Archetypes.Empty();
+	ArchetypeLookup.Empty();
+	SpawnEntries.Empty();
+	SpawnTimeline.Empty();
+	ActiveSpawnArchetypes.Empty();
+	ActiveSpawnWeights.Empty();
+	ActiveSpawnTable.Reset();
 
 	Super::Deinitialize();
 }
@@ -48,12 +75,41 @@ bool UEnemySpawnSubsystem::ShouldCreateSubsystem(UObject* Outer) const
 	return false;
 }
 
+TStatId UEnemySpawnSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UEnemySpawnSubsystem, STATGROUP_Tickables);
+}
+
+void UEnemySpawnSubsystem::Tick(float DeltaTime)
+{
+	ProcessDeaths();
+
+	if (bIsSpawning)
+	{
+		UpdateSpawning(DeltaTime);
+		GrowPool();
+
+		// The HUD used to refresh on every spawn; at batch rates that is too often
+		DebugHUDTimer += DeltaTime;
+		if (DebugHUDTimer >= 0.25f)
+		{
+			DebugHUDTimer = 0.0f;
+			UpdateDebugHUD();
+		}
+	}
+}
+
 void UEnemySpawnSubsystem::Configure(TSubclassOf<ASurvivorEnemy> InEnemyClass, UDataTable* InEnemyDataTable, UDataTable* InSpawnConfigTable)
 {
 	EnemyClass = InEnemyClass;
 	EnemyDataTable = InEnemyDataTable;
 	SpawnConfigTable = InSpawnConfigTable;
 	bIsConfigured = true;
+
+	if (EnemyDataTable)
+	{
+		RebuildArchetypes();
+	}
 }
 
 void UEnemySpawnSubsystem::LoadDefaultAssets()
@@ -98,84 +154,500 @@ void UEnemySpawnSubsystem::StartSpawning()
 		return;
 	}
 
+	// Compile enemy types once; after this spawning never touches the DataTables
+	if (!bArchetypesBuilt)
+	{
+		RebuildArchetypes();
+	}
+
 	// Cache floor bounds for spawn location clamping
 	CacheFloorBounds();
 
-	// Pre-warm the pool
-	PreWarmPool(PreWarmCount);
+	// Start streaming the types that unlock soon, and keep looking ahead on the spawn timeline
+	UpdateAssetStreaming();
+	if (UWorld* World = GetWorld())
+	{
+		World->GetTimerManager().SetTimer(
+			StreamingTimerHandle,
+			this,
+			&UEnemySpawnSubsystem::UpdateAssetStreaming,
+			FMath::Max(StreamingCheckInterval, 0.1f),
+			true
+		);
+	}
+
+	// Pre-warm and headroom growth happen in Tick, a few enemies per frame
+	bIsSpawning = true;
 
-	// Start spawn timer
-	SpawnEnemy();
+	// Enough credit for the first enemy on the next tick
+	SpawnCredit = 1.0f;
+	WaveTimer = 0.0f;
+	NumWaves = 0;
 }
 
 void UEnemySpawnSubsystem::StopSpawning()
 {
+	bIsSpawning = false;
+	SpawnCredit = 0.0f;
+	Bursts.Reset();
+
 	if (UWorld* World = GetWorld())
 	{
-		World->GetTimerManager().ClearTimer(SpawnTimerHandle);
+		World->GetTimerManager().ClearTimer(StreamingTimerHandle);
 	}
 }
 
-void UEnemySpawnSubsystem::PreWarmPool(int32 Count)
+void UEnemySpawnSubsystem::UpdateAssetStreaming()
 {
 	UWorld* World = GetWorld();
-	if (!World || !EnemyClass)
+	const float ElapsedSeconds = World ? World->GetTimeSeconds() : 0.0f;
+	const float LookaheadMinutes = (ElapsedSeconds + AssetLookaheadSeconds) / 60.0f;
+	const float ElapsedMinutes = ElapsedSeconds / 60.0f;
+
+	for (const FCompiledSpawnEntry& Entry : SpawnEntries)
+	{
+		const bool bDeprecated = Entry.MinuteDeprecate > 0.0f && ElapsedMinutes >= Entry.MinuteDeprecate;
+		if (bDeprecated)
+		{
+			// Never spawns again; let the assets go once live enemies stop referencing them
+			TSharedPtr<FStreamableHandle> Handle;
+			if (EnemyAssetHandles.RemoveAndCopyValue(Entry.Archetype, Handle) && Handle.IsValid())
+			{
+				Handle->ReleaseHandle();
+			}
+		}
+		else if (Entry.MinuteUnlock <= LookaheadMinutes)
+		{
+			RequestEnemyAssets(Entry.Archetype);
+		}
+	}
+
+	int32 NumStreaming = 0;
+	for (const TPair<int32, TSharedPtr<FStreamableHandle>>& Pair : EnemyAssetHandles)
+	{
+		NumStreaming += Pair.Value.IsValid() && Pair.Value->IsLoadingInProgress() ? 1 : 0;
+	}
+	SET_DWORD_STAT(STAT_EnemyTypesStreaming, NumStreaming);
+}
+
+void UEnemySpawnSubsystem::RequestEnemyAssets(int32 ArchetypeIndex)
+{
+	if (!Archetypes.IsValidIndex(ArchetypeIndex) || EnemyAssetHandles.Contains(ArchetypeIndex))
 	{
 		return;
 	}
 
-	for (int32 i = 0; i < Count; i++)
+	const FEnemyTableRow* Row = Archetypes[ArchetypeIndex].Row;
+	TArray<FSoftObjectPath> Paths;
+	if (!Row->EnemyMesh.IsNull())
+	{
+		Paths.Add(Row->EnemyMesh.ToSoftObjectPath());
+	}
+	if (!Row->EnemyMaterial.IsNull())
 	{
-		FActorSpawnParameters Params;
-		Params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		Paths.Add(Row->EnemyMaterial.ToSoftObjectPath());
+	}
 
-		ASurvivorEnemy* Enemy = World->SpawnActor<ASurvivorEnemy>(
-			EnemyClass,
-			FVector(0.0f, 0.0f, 100.0f),  // Spawn at valid Z (floor is at Z=0)
-			FRotator::ZeroRotator,
-			Params
-		);
+	// The handle keeps the assets resident for as long as the type can spawn
+	TSharedPtr<FStreamableHandle> Handle;
+	if (Paths.Num() > 0)
+	{
+		Handle = StreamableManager.RequestAsyncLoad(Paths,
+			FStreamableDelegate::CreateUObject(this, &UEnemySpawnSubsystem::OnEnemyAssetsLoaded),
+			FStreamableManager::AsyncLoadHighPriority);
+	}
+	EnemyAssetHandles.Add(ArchetypeIndex, Handle);
+}
+
+void UEnemySpawnSubsystem::OnEnemyAssetsLoaded()
+{
+	// A type may have become spawnable mid-window
+	bActiveSetDirty = true;
+}
+
+bool UEnemySpawnSubsystem::AreArchetypeAssetsResident(int32 ArchetypeIndex) const
+{
+	if (!Archetypes.IsValidIndex(ArchetypeIndex))
+	{
+		return false;
+	}
+
+	const FEnemyArchetype& Archetype = Archetypes[ArchetypeIndex];
+	if (Archetype.bAssetsResolved)
+	{
+		return true;
+	}
+
+	const FEnemyTableRow* Row = Archetype.Row;
+	return (Row->EnemyMesh.IsNull() || Row->EnemyMesh.Get())
+		&& (Row->EnemyMaterial.IsNull() || Row->EnemyMaterial.Get());
+}
+
+int32 UEnemySpawnSubsystem::AddArchetype(const UDataTable* DataTable, FName RowName, const FEnemyTableRow& Row)
+{
+	FEnemyArchetype& Archetype = Archetypes.AddDefaulted_GetRef();
+	Archetype.RowName = RowName;
+	Archetype.Row = &Row;
+	Archetype.MeshScale = Row.MeshScale;
+	Archetype.Color = Row.EnemyColor;
+	Archetype.EmissiveStrength = Row.EmissiveStrength;
+
+	Archetype.MaxHealth = Row.BaseHealth;
+	Archetype.MoveSpeed = Row.MoveSpeed;
+	Archetype.BaseDamage = Row.BaseDamage;
+
+	// Max HP doubles as knockback mass; resistance follows from it
+	Archetype.KnockbackMass = FMath::Max(1.0f, Row.BaseHealth);
+	Archetype.KnockbackResistance = KnockbackSettings::GetResistanceForHealth(Archetype.KnockbackMass);
+
+	// Greedy gem split for every XP value the type can drop
+	Archetype.MinXP = FMath::Max(0, Row.MinXP);
+	Archetype.MaxXP = FMath::Max(Archetype.MinXP, Row.MaxXP);
+	const int32 NumValues = Archetype.MaxXP - Archetype.MinXP + 1;
+	Archetype.GemCounts.SetNumZeroed(NumValues * GemSettings::NumTiers);
+	for (int32 Value = 0; Value < NumValues; ++Value)
+	{
+		int32 Remaining = Archetype.MinXP + Value;
+		for (int32 Tier = 0; Tier < GemSettings::NumTiers; ++Tier)
+		{
+			Archetype.GemCounts[Value * GemSettings::NumTiers + Tier] = uint16(Remaining / GemSettings::Tiers[Tier]);
+			Remaining %= GemSettings::Tiers[Tier];
+		}
+	}
+
+	const int32 Index = Archetypes.Num() - 1;
+	ArchetypeLookup.Add(TPair<const UDataTable*, FName>(DataTable, RowName), Index);
+	return Index;
+}
+
+int32 UEnemySpawnSubsystem::FindOrAddArchetype(UDataTable* DataTable, FName RowName)
+{
+	if (!DataTable || RowName.IsNone())
+	{
+		return INDEX_NONE;
+	}
+
+	if (const int32* Existing = ArchetypeLookup.Find(TPair<const UDataTable*, FName>(DataTable, RowName)))
+	{
+		return *Existing;
+	}
+
+	const FEnemyTableRow* Row = DataTable->FindRow<FEnemyTableRow>(RowName, TEXT("EnemyArchetype"));
+	if (!Row)
+	{
+		return INDEX_NONE;
+	}
+
+	WatchTable(DataTable);
+	return AddArchetype(DataTable, RowName, *Row);
+}
 
+void UEnemySpawnSubsystem::ResolveArchetypeAssets(int32 ArchetypeIndex)
+{
+	if (!Archetypes.IsValidIndex(ArchetypeIndex) || Archetypes[ArchetypeIndex].bAssetsResolved)
+	{
+		return;
+	}
+
+	FEnemyArchetype& Archetype = Archetypes[ArchetypeIndex];
+	Archetype.Mesh = ResolveEnemyAsset(Archetype.Row->EnemyMesh);
+	Archetype.BaseMaterial = ResolveEnemyAsset(Archetype.Row->EnemyMaterial);
+	Archetype.SharedMaterial = Archetype.BaseMaterial;
+	if (UHordeRenderSubsystem* RenderSubsystem = GetWorld()->GetSubsystem<UHordeRenderSubsystem>())
+	{
+		Archetype.SharedMaterial = RenderSubsystem->GetSharedEnemyMaterial(ArchetypeIndex, Archetype);
+	}
+	Archetype.bAssetsResolved = true;
+}
+
+void UEnemySpawnSubsystem::RebuildArchetypes()
+{
+	// Handles are keyed by archetype index; UpdateAssetStreaming re-requests (cheap when already loaded)
+	for (const TPair<int32, TSharedPtr<FStreamableHandle>>& Pair : EnemyAssetHandles)
+	{
+		if (Pair.Value.IsValid())
+		{
+			Pair.Value->ReleaseHandle();
+		}
+	}
+	EnemyAssetHandles.Reset();
+
+	UnwatchTables();
+	Archetypes.Reset();
+	ArchetypeLookup.Reset();
+
+	// Shared materials are keyed by archetype index, which the rebuild reassigns
+	if (UHordeRenderSubsystem* RenderSubsystem = GetWorld()->GetSubsystem<UHordeRenderSubsystem>())
+	{
+		RenderSubsystem->ResetSharedEnemyMaterials();
+	}
+	SpawnEntries.Reset();
+	SpawnTimeline.Reset();
+	bActiveSetDirty = true;
+
+	if (!EnemyDataTable)
+	{
+		return;
+	}
+
+	WatchTable(EnemyDataTable);
+	for (const TPair<FName, uint8*>& Pair : EnemyDataTable->GetRowMap())
+	{
+		AddArchetype(EnemyDataTable, Pair.Key, *reinterpret_cast<const FEnemyTableRow*>(Pair.Value));
+	}
+
+	// Spawn timeline: every row of DT_EnemySpawns, or just the first enemy when there is none
+	if (SpawnConfigTable)
+	{
+		WatchTable(SpawnConfigTable);
+		for (const TPair<FName, uint8*>& Pair : SpawnConfigTable->GetRowMap())
+		{
+			const FEnemySpawnEntry& Row = *reinterpret_cast<const FEnemySpawnEntry*>(Pair.Value);
+			const int32* Archetype = ArchetypeLookup.Find(TPair<const UDataTable*, FName>(EnemyDataTable, Row.EnemyRowName));
+			if (!Archetype)
+			{
+				UE_LOG(LogTemp, Warning, TEXT("EnemySpawnSubsystem: spawn row '%s' references unknown enemy '%s'"), *Pair.Key.ToString(), *Row.EnemyRowName.ToString());
+				continue;
+			}
+			SpawnEntries.Add({ *Archetype, Row.Weight, Row.MinuteUnlock, Row.MinuteDeprecate });
+		}
+	}
+	else if (Archetypes.Num() > 0)
+	{
+		SpawnEntries.Add({ 0, 1.0f, 0.0f, 0.0f });
+	}
+
+	for (const FCompiledSpawnEntry& Entry : SpawnEntries)
+	{
+		if (Entry.MinuteUnlock > 0.0f)
+		{
+			SpawnTimeline.Add(Entry.MinuteUnlock);
+		}
+		if (Entry.MinuteDeprecate > 0.0f)
+		{
+			SpawnTimeline.Add(Entry.MinuteDeprecate);
+		}
+	}
+	SpawnTimeline.Sort();
+	SpawnTimeline.SetNum(Algo::Unique(SpawnTimeline));
+
+	// Live, pooled and dying enemies still point at the old rows (and old archetype indices)
+	auto Repoint = [this](ASurvivorEnemy* Enemy)
+	{
 		if (Enemy)
 		{
-			Enemy->Deactivate();
-			EnemyPool.Add(Enemy);
+			Enemy->ArchetypeIndex = FindOrAddArchetype(Enemy->EnemyDataTable, Enemy->EnemyRowName);
+			Enemy->EnemyData = Archetypes.IsValidIndex(Enemy->ArchetypeIndex) ? Archetypes[Enemy->ArchetypeIndex].Row : nullptr;
 		}
+	};
+	for (ASurvivorEnemy* Enemy : ActiveEnemies)
+	{
+		Repoint(Enemy);
+	}
+	for (ASurvivorEnemy* Enemy : EnemyPool)
+	{
+		Repoint(Enemy);
+	}
+
+	// Deaths queued this frame are in neither list yet and carry the archetype they died as
+	for (FPendingDeath& Death : PendingDeaths)
+	{
+		Repoint(Death.Enemy);
+		Death.Archetype = Death.Enemy->ArchetypeIndex;
+	}
+
+	bArchetypesBuilt = true;
+	UE_LOG(LogTemp, Log, TEXT("EnemySpawnSubsystem: compiled %d enemy archetypes, %d spawn entries"), Archetypes.Num(), SpawnEntries.Num());
+
+	if (StreamingTimerHandle.IsValid())
+	{
+		UpdateAssetStreaming();
 	}
 }
 
-ASurvivorEnemy* UEnemySpawnSubsystem::GetEnemyFromPool()
+void UEnemySpawnSubsystem::WatchTable(UDataTable* Table)
 {
-	if (EnemyPool.Num() > 0)
+	if (Table && !WatchedTables.Contains(Table))
 	{
-		ASurvivorEnemy* Enemy = EnemyPool.Pop();
-		ActiveEnemies.Add(Enemy);
-		return Enemy;
+		Table->OnDataTableChanged().AddUObject(this, &UEnemySpawnSubsystem::OnTableChanged);
+		WatchedTables.Add(Table);
+	}
+}
+
+void UEnemySpawnSubsystem::UnwatchTables()
+{
+	for (const TWeakObjectPtr<UDataTable>& Table : WatchedTables)
+	{
+		if (Table.IsValid())
+		{
+			Table->OnDataTableChanged().RemoveAll(this);
+		}
 	}
+	WatchedTables.Reset();
+}
+
+void UEnemySpawnSubsystem::OnTableChanged()
+{
+	// DataTable hot reload (or edit during PIE) reallocates rows; recompile everything
+	RebuildArchetypes();
+}
+
+int32 UEnemySpawnSubsystem::GetDesiredPoolHeadroom()
+{
+	const int32 NumActive = ActiveEnemies.Num();
+
+	// Enough for the next PoolHeadroomSeconds of spawns (the rate already includes the
+	// responsive bonus toward the target count), and the initial pre-warm
+	const float SpawnsPerSecond = GetCurrentSpawnRate() / 60.0f;
+	int32 Desired = FMath::Max(FMath::CeilToInt32(SpawnsPerSecond * PoolHeadroomSeconds), MinPoolHeadroom);
+	Desired = FMath::Max(Desired, PreWarmCount - NumActive);
+
+	// Queued bursts arrive on top of the trickle
+	Desired += GetPendingBurstSpawns();
+
+	// Never more than could be alive at once
+	return FMath::Clamp(Desired, 0, MaxEnemiesOnMap - NumActive);
+}
+
+void UEnemySpawnSubsystem::GrowPool()
+{
+	const int32 Desired = GetDesiredPoolHeadroom();
+	if (EnemyPool.Num() >= Desired)
+	{
+		return;
+	}
+
+	// Always make progress (one spawn), then keep going while there is budget left
+	const double Deadline = FPlatformTime::Seconds() + PoolGrowthBudgetMs * 0.001;
+	do
+	{
+		ASurvivorEnemy* Enemy = SpawnPooledEnemy();
+		if (!Enemy)
+		{
+			return;
+		}
+		EnemyPool.Add(Enemy);
+	}
+	while (EnemyPool.Num() < Desired && FPlatformTime::Seconds() < Deadline);
+}
 
-	// Pool empty - spawn new enemy
+ASurvivorEnemy* UEnemySpawnSubsystem::SpawnPooledEnemy()
+{
 	UWorld* World = GetWorld();
-	if (World && EnemyClass)
+	if (!World || !EnemyClass)
 	{
-		FActorSpawnParameters Params;
-		Params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		return nullptr;
+	}
 
-		ASurvivorEnemy* Enemy = World->SpawnActor<ASurvivorEnemy>(
-			EnemyClass,
-			FVector::ZeroVector,
-			FRotator::ZeroRotator,
-			Params
-		);
+	FActorSpawnParameters Params;
+	Params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
 
-		if (Enemy)
+	ASurvivorEnemy* Enemy = World->SpawnActor<ASurvivorEnemy>(
+		EnemyClass,
+		FVector(0.0f, 0.0f, 100.0f),  // Spawn at valid Z (floor is at Z=0)
+		FRotator::ZeroRotator,
+		Params
+	);
+
+	if (Enemy)
+	{
+		// BeginPlay adopts enemies whose Blueprint defaults name a row; undo that here
+		if (Enemy->PoolSlot == INDEX_NONE)
 		{
-			Enemy->Deactivate();  // Start deactivated, will be reinitialized
-			ActiveEnemies.Add(Enemy);
-			return Enemy;
+			Enemy->PoolSlot = AllocatePoolSlot(Enemy);
 		}
+		if (Enemy->ActiveIndex != INDEX_NONE)
+		{
+			DeactivateEnemy(Enemy);
+		}
+		Enemy->Deactivate();  // Start deactivated, will be reinitialized
+	}
+	return Enemy;
+}
+
+int32 UEnemySpawnSubsystem::AllocatePoolSlot(ASurvivorEnemy* Enemy)
+{
+	SlotGenerations.Add(0);
+	return SlotEnemies.Add(Enemy);
+}
+
+void UEnemySpawnSubsystem::ActivateEnemy(ASurvivorEnemy* Enemy)
+{
+	Enemy->ActiveIndex = ActiveEnemies.Add(Enemy);
+	++SlotGenerations[Enemy->PoolSlot];  // Now odd: handles resolve
+}
+
+void UEnemySpawnSubsystem::DeactivateEnemy(ASurvivorEnemy* Enemy)
+{
+	// Swap-remove and patch the index of the enemy moved into the hole
+	const int32 Index = Enemy->ActiveIndex;
+	ActiveEnemies.RemoveAtSwap(Index, EAllowShrinking::No);
+	if (ActiveEnemies.IsValidIndex(Index))
+	{
+		ActiveEnemies[Index]->ActiveIndex = Index;
+	}
+
+	Enemy->ActiveIndex = INDEX_NONE;
+	++SlotGenerations[Enemy->PoolSlot];  // Now even: every outstanding handle is stale
+}
+
+void UEnemySpawnSubsystem::AdoptEnemy(ASurvivorEnemy* Enemy)
+{
+	if (!Enemy)
+	{
+		return;
+	}
+
+	if (Enemy->PoolSlot == INDEX_NONE)
+	{
+		Enemy->PoolSlot = AllocatePoolSlot(Enemy);
+	}
+	if (Enemy->ActiveIndex == INDEX_NONE)
+	{
+		ActivateEnemy(Enemy);
+	}
+}
+
+FEnemyHandle UEnemySpawnSubsystem::GetEnemyHandle(const ASurvivorEnemy* Enemy) const
+{
+	FEnemyHandle Handle;
+	if (Enemy && Enemy->ActiveIndex != INDEX_NONE && SlotGenerations.IsValidIndex(Enemy->PoolSlot))
+	{
+		Handle.Index = Enemy->PoolSlot;
+		Handle.Generation = SlotGenerations[Enemy->PoolSlot];
+	}
+	return Handle;
+}
+
+ASurvivorEnemy* UEnemySpawnSubsystem::ResolveEnemy(FEnemyHandle Handle) const
+{
+	if (!SlotGenerations.IsValidIndex(Handle.Index))
+	{
+		return nullptr;
 	}
 
-	return nullptr;
+	const uint32 Generation = SlotGenerations[Handle.Index];
+	return (Generation & 1) && Generation == Handle.Generation ? SlotEnemies[Handle.Index] : nullptr;
+}
+
+ASurvivorEnemy* UEnemySpawnSubsystem::GetEnemyFromPool()
+{
+	if (EnemyPool.Num() > 0)
+	{
+		ASurvivorEnemy* Enemy = EnemyPool.Pop();
+		ActivateEnemy(Enemy);
+		return Enemy;
+	}
+
+	// Headroom exhausted (demand outran pool growth) - spawn synchronously
+	ASurvivorEnemy* Enemy = SpawnPooledEnemy();
+	if (Enemy)
+	{
+		INC_DWORD_STAT(STAT_EnemyPoolSyncSpawns);
+		NumPoolSyncSpawns++;
+		ActivateEnemy(Enemy);
+	}
+	return Enemy;
 }
 
 void UEnemySpawnSubsystem::ReturnEnemyToPool(ASurvivorEnemy* Enemy)
@@ -185,161 +657,289 @@ void UEnemySpawnSubsystem::ReturnEnemyToPool(ASurvivorEnemy* Enemy)
 		return;
 	}
 
-	ActiveEnemies.Remove(Enemy);
+	// Level-placed enemy the simulation never registered: give it a slot so it can be pooled
+	if (Enemy->PoolSlot == INDEX_NONE)
+	{
+		AdoptEnemy(Enemy);
+	}
+
+	// Already pooled
+	if (Enemy->ActiveIndex == INDEX_NONE)
+	{
+		return;
+	}
+
+	DeactivateEnemy(Enemy);
 	Enemy->Deactivate();
 	EnemyPool.Add(Enemy);
 }
 
 void UEnemySpawnSubsystem::OnEnemyDeath(ASurvivorEnemy* Enemy)
 {
-	// Return to pool after short delay (allows death effects)
-	ReturnEnemyToPool(Enemy);
+	if (!Enemy)
+	{
+		return;
+	}
+
+	if (Enemy->PoolSlot == INDEX_NONE)
+	{
+		AdoptEnemy(Enemy);
+	}
+
+	// Already queued (or pooled)
+	if (Enemy->ActiveIndex == INDEX_NONE)
+	{
+		return;
+	}
+
+	// Out of the active set right away so targeting never sees it; the rest waits for the batch
+	DeactivateEnemy(Enemy);
+	PendingDeaths.Add({ Enemy, Enemy->ArchetypeIndex, Enemy->GetActorLocation() });
 }
 
-void UEnemySpawnSubsystem::SpawnEnemy()
+void UEnemySpawnSubsystem::ProcessDeaths()
 {
-	UWorld* World = GetWorld();
-	if (!World)
+	if (PendingDeaths.Num() == 0)
 	{
-		UE_LOG(LogTemp, Error, TEXT("SpawnEnemy: No world!"));
 		return;
 	}
 
-	// Check enemy cap
-	if (ActiveEnemies.Num() < MaxEnemiesOnMap)
+	// Every gem of every death this frame, from the per-archetype decomposition tables
+	GemRequests.Reset();
+	for (const FPendingDeath& Death : PendingDeaths)
 	{
-		// Select enemy type first - skip spawn if no valid type
-		FName EnemyType = SelectEnemyType();
-		if (EnemyType.IsNone())
+		const FEnemyArchetype* Archetype = GetArchetype(Death.Archetype);
+		if (!Archetype)
 		{
-			UE_LOG(LogTemp, Warning, TEXT("SpawnEnemy: No valid enemy type available"));
+			continue;
 		}
-		else
+
+		const uint16* GemCounts = Archetype->GetGemCounts(FMath::RandRange(Archetype->MinXP, Archetype->MaxXP));
+		for (int32 Tier = 0; Tier < GemSettings::NumTiers; ++Tier)
 		{
-			// Get enemy from pool
-			ASurvivorEnemy* Enemy = GetEnemyFromPool();
-			if (Enemy)
-			{
-				FVector Location = GetSpawnLocation();
-				Enemy->Reinitialize(EnemyDataTable, EnemyType, Location);
-			}
-			else
+			for (int32 Gem = 0; Gem < GemCounts[Tier]; ++Gem)
 			{
-				UE_LOG(LogTemp, Warning, TEXT("SpawnEnemy: Failed to get enemy from pool"));
+				FVector SpawnLoc = Death.Location + FMath::VRand() * GemSettings::ScatterRadius;
+				SpawnLoc.Z = Death.Location.Z; // Keep at same height roughly
+				GemRequests.Add({ SpawnLoc, GemSettings::Tiers[Tier] });
 			}
 		}
 	}
 
-	// Schedule next spawn
-	float SpawnRate = GetCurrentSpawnRate();
-	float Interval = 60.0f / SpawnRate;  // Convert spawns/min to seconds
+	if (GemRequests.Num() > 0)
+	{
+		if (UXPGemSubsystem* GemSubsystem = GetWorld()->GetSubsystem<UXPGemSubsystem>())
+		{
+			GemSubsystem->SpawnGems(GemRequests);
+		}
+	}
 
-	World->GetTimerManager().SetTimer(
-		SpawnTimerHandle,
-		this,
-		&UEnemySpawnSubsystem::SpawnEnemy,
-		Interval,
-		false  // Not looping - we recalculate each time
-	);
+	// Pool returns together (already out of ActiveEnemies)
+	for (const FPendingDeath& Death : PendingDeaths)
+	{
+		Death.Enemy->Deactivate();
+		EnemyPool.Add(Death.Enemy);
+	}
 
-	// Update debug display
-	UpdateDebugHUD();
+	PendingDeaths.Reset();
 }
 
-FVector UEnemySpawnSubsystem::GetSpawnLocation()
+void UEnemySpawnSubsystem::SpawnBurst(int32 Count, float Duration)
+{
+	if (Count <= 0)
+	{
+		return;
+	}
+
+	Bursts.Add({ Count, Duration > 0.0f ? Count / Duration : 0.0f, 0.0f });
+}
+
+int32 UEnemySpawnSubsystem::GetPendingBurstSpawns() const
+{
+	int32 Pending = 0;
+	for (const FSpawnBurst& Burst : Bursts)
+	{
+		Pending += Burst.Remaining;
+	}
+	return Pending;
+}
+
+void UEnemySpawnSubsystem::UpdateSpawning(float DeltaTime)
 {
 	UWorld* World = GetWorld();
 	if (!World)
 	{
-		return FVector::ZeroVector;
+		return;
 	}
 
-	ACharacter* Player = UGameplayStatics::GetPlayerCharacter(World, 0);
-	if (!Player)
+	// Trickle: the spawn rate accrues as fractional credit, so high rates spawn several per frame
+	SpawnCredit += GetCurrentSpawnRate() / 60.0f * DeltaTime;
+
+	// Periodic waves are just bursts that grow with time
+	if (WaveInterval > 0.0f)
 	{
-		return FVector::ZeroVector;
+		WaveTimer += DeltaTime;
+		if (WaveTimer >= WaveInterval)
+		{
+			WaveTimer -= WaveInterval;
+			NumWaves++;
+			const float ElapsedMinutes = World->GetTimeSeconds() / 60.0f;
+			SpawnBurst(FMath::RoundToInt32(WaveBaseSize + ElapsedMinutes * WaveSizeGrowth), WaveDuration);
+		}
 	}
 
-	FVector PlayerLoc = Player->GetActorLocation();
-
-	// Random angle around player
-	float Angle = FMath::RandRange(0.0f, 360.0f);
-	float Distance = SpawnRadius + FMath::RandRange(0.0f, SpawnMargin);
+	int32 BurstDue = 0;
+	for (FSpawnBurst& Burst : Bursts)
+	{
+		Burst.Credit = Burst.PerSecond > 0.0f ? Burst.Credit + Burst.PerSecond * DeltaTime : static_cast<float>(Burst.Remaining);
+		BurstDue += FMath::Min(FMath::FloorToInt32(Burst.Credit), Burst.Remaining);
+	}
 
-	FVector Offset;
-	Offset.X = FMath::Cos(FMath::DegreesToRadians(Angle)) * Distance;
-	Offset.Y = FMath::Sin(FMath::DegreesToRadians(Angle)) * Distance;
-	Offset.Z = 0.0f;
+	// One batch for everything due, bursts first, within the frame budget and the map cap
+	const int32 Capacity = FMath::Max(0, MaxEnemiesOnMap - ActiveEnemies.Num());
+	const int32 Budget = FMath::Min(MaxSpawnsPerFrame, Capacity);
+	const int32 NumBurst = FMath::Min(BurstDue, Budget);
+	const int32 NumTrickle = FMath::Min(FMath::FloorToInt32(SpawnCredit), Budget - NumBurst);
+	const int32 NumSpawned = SpawnBatch(NumBurst + NumTrickle);
 
-	FVector SpawnLoc = PlayerLoc + Offset;
+	// Charge what was spawned to the bursts in queue order, the rest to the trickle
+	int32 BurstSpawned = FMath::Min(NumSpawned, NumBurst);
+	for (FSpawnBurst& Burst : Bursts)
+	{
+		const int32 Taken = FMath::Min3(BurstSpawned, FMath::FloorToInt32(Burst.Credit), Burst.Remaining);
+		Burst.Remaining -= Taken;
+		Burst.Credit -= Taken;
+		BurstSpawned -= Taken;
+	}
+	Bursts.RemoveAll([](const FSpawnBurst& Burst) { return Burst.Remaining <= 0; });
+	SpawnCredit -= NumSpawned - FMath::Min(NumSpawned, NumBurst);
 
-	// Clamp to floor bounds if available
-	return ClampToFloorBounds(SpawnLoc);
+	// Don't bank trickle spawns while capped (the old timer dropped them), and never carry
+	// more than one frame's budget
+	SpawnCredit = FMath::Min(SpawnCredit, Capacity > 0 ? static_cast<float>(MaxSpawnsPerFrame) : 1.0f);
 }
 
-FName UEnemySpawnSubsystem::SelectEnemyType()
+int32 UEnemySpawnSubsystem::SpawnBatch(int32 Count)
 {
-	// If no spawn config, return first row from enemy table
-	if (!SpawnConfigTable)
+	if (Count <= 0)
 	{
-		if (EnemyDataTable)
-		{
-			TArray<FName> RowNames = EnemyDataTable->GetRowNames();
-			if (RowNames.Num() > 0)
-			{
-				return RowNames[0];
-			}
-		}
-		else
+		return 0;
+	}
+
+	// Types and locations for the whole batch up front (one pass over the spawn table, one player lookup)
+	if (!SelectEnemyArchetypes(Count, BatchArchetypes))
+	{
+		UE_LOG(LogTemp, Verbose, TEXT("SpawnBatch: No enemy type ready (unlocked types may still be streaming)"));
+		return 0;
+	}
+	GetSpawnLocations(Count, BatchLocations);
+
+	int32 NumSpawned = 0;
+	for (int32 i = 0; i < Count; ++i)
+	{
+		ASurvivorEnemy* Enemy = GetEnemyFromPool();
+		if (!Enemy)
 		{
-			UE_LOG(LogTemp, Error, TEXT("SelectEnemyType: Both SpawnConfigTable and EnemyDataTable are NULL!"));
+			UE_LOG(LogTemp, Warning, TEXT("SpawnBatch: Failed to get enemy from pool"));
+			break;
 		}
-		return NAME_None;
+
+		Enemy->Reinitialize(BatchArchetypes[i], BatchLocations[i]);
+		NumSpawned++;
 	}
+	return NumSpawned;
+}
+
+void UEnemySpawnSubsystem::GetSpawnLocations(int32 Count, TArray<FVector>& OutLocations)
+{
+	OutLocations.Reset();
 
 	UWorld* World = GetWorld();
-	float ElapsedMinutes = World ? World->GetTimeSeconds() / 60.0f : 0.0f;
+	ACharacter* Player = World ? UGameplayStatics::GetPlayerCharacter(World, 0) : nullptr;
+	if (!Player)
+	{
+		OutLocations.Init(FVector::ZeroVector, Count);
+		return;
+	}
 
-	// Gather available enemy types (unlocked based on time)
-	TArray<FEnemySpawnEntry*> Available;
-	float TotalWeight = 0.0f;
+	const FVector PlayerLoc = Player->GetActorLocation();
 
-	TArray<FName> RowNames = SpawnConfigTable->GetRowNames();
-	for (const FName& RowName : RowNames)
+	for (int32 i = 0; i < Count; ++i)
 	{
-		FEnemySpawnEntry* Entry = SpawnConfigTable->FindRow<FEnemySpawnEntry>(RowName, TEXT(""));
-		if (Entry && ElapsedMinutes >= Entry->MinuteUnlock)
-		{
-			// Check if deprecated (0 means never expires)
-			if (Entry->MinuteDeprecate > 0.0f && ElapsedMinutes >= Entry->MinuteDeprecate)
-			{
-				continue;  // Skip deprecated enemy types
-			}
-			Available.Add(Entry);
-			TotalWeight += Entry->Weight;
-		}
+		// Random angle around player, just outside the camera
+		float Angle = FMath::RandRange(0.0f, 2.0f * PI);
+		float Distance = SpawnRadius + FMath::RandRange(0.0f, SpawnMargin);
+
+		float Sin, Cos;
+		FMath::SinCos(&Sin, &Cos, Angle);
+		const FVector SpawnLoc = PlayerLoc + FVector(Cos * Distance, Sin * Distance, 0.0f);
+
+		// Clamp to floor bounds if available
+		OutLocations.Add(ClampToFloorBounds(SpawnLoc));
 	}
+}
 
-	// Weighted random selection
-	if (Available.Num() > 0 && TotalWeight > 0.0f)
+bool UEnemySpawnSubsystem::SelectEnemyArchetypes(int32 Count, TArray<int32>& OutArchetypes)
+{
+	OutArchetypes.Reset();
+
+	if (SpawnEntries.Num() == 0)
 	{
-		float Roll = FMath::RandRange(0.0f, TotalWeight);
-		float Cumulative = 0.0f;
+		UE_LOG(LogTemp, Error, TEXT("SelectEnemyArchetypes: no compiled spawn entries (EnemyDataTable empty or missing?)"));
+		return false;
+	}
 
-		for (FEnemySpawnEntry* Entry : Available)
-		{
-			Cumulative += Entry->Weight;
-			if (Roll <= Cumulative)
-			{
-				return Entry->EnemyRowName;
-			}
-		}
+	UWorld* World = GetWorld();
+	RefreshActiveSpawnSet(World ? World->GetTimeSeconds() / 60.0f : 0.0f);
+	if (ActiveSpawnTable.Num() == 0)
+	{
+		return false;
+	}
 
-		// Fallback to last
-		return Available.Last()->EnemyRowName;
+	// O(1) weighted pick per spawn
+	for (int32 i = 0; i < Count; ++i)
+	{
+		OutArchetypes.Add(ActiveSpawnArchetypes[ActiveSpawnTable.Sample()]);
+	}
+	return true;
+}
+
+void UEnemySpawnSubsystem::RefreshActiveSpawnSet(float ElapsedMinutes)
+{
+	if (!bActiveSetDirty && ElapsedMinutes >= ActiveSetStartMinute && ElapsedMinutes < ActiveSetEndMinute)
+	{
+		return;
 	}
 
-	return NAME_None;
+	// Cleared first: a load completing inside RequestEnemyAssets below re-dirties the set
+	bActiveSetDirty = false;
+
+	const int32 Next = Algo::UpperBound(SpawnTimeline, ElapsedMinutes);
+	ActiveSetStartMinute = Next > 0 ? SpawnTimeline[Next - 1] : -MAX_flt;
+	ActiveSetEndMinute = Next < SpawnTimeline.Num() ? SpawnTimeline[Next] : MAX_flt;
+
+	ActiveSpawnArchetypes.Reset();
+	ActiveSpawnWeights.Reset();
+	for (const FCompiledSpawnEntry& Entry : SpawnEntries)
+	{
+		if (ElapsedMinutes < Entry.MinuteUnlock)
+		{
+			continue;
+		}
+		// Check if deprecated (0 means never expires)
+		if (Entry.MinuteDeprecate > 0.0f && ElapsedMinutes >= Entry.MinuteDeprecate)
+		{
+			continue;  // Skip deprecated enemy types
+		}
+		if (!AreArchetypeAssetsResident(Entry.Archetype))
+		{
+			RequestEnemyAssets(Entry.Archetype);  // Late unlock (e.g. table edited); OnEnemyAssetsLoaded re-dirties the set
+			continue;
+		}
+		ActiveSpawnArchetypes.Add(Entry.Archetype);
+		ActiveSpawnWeights.Add(Entry.Weight);
+	}
+	ActiveSpawnTable.Build(ActiveSpawnWeights);
 }
 
 float UEnemySpawnSubsystem::GetCurrentSpawnRate()
@@ -445,48 +1045,13 @@ void UEnemySpawnSubsystem::UpdateDebugHUD()
 	float TotalRate = FMath::Min(TimeBasedRate + ResponsiveBonus, MaxSpawnRate);
 	float SpawnsPerSecond = TotalRate / 60.0f;
 
-	// Find latest unlocked and active enemy types
-	FString UnlockedTypes = TEXT("");
+	// Active enemy types (the set the alias table samples from)
+	RefreshActiveSpawnSet(ElapsedMinutes);
 	FString ActiveTypes = TEXT("");
-	if (SpawnConfigTable)
+	for (int32 ArchetypeIndex : ActiveSpawnArchetypes)
 	{
-		TArray<FName> RowNames = SpawnConfigTable->GetRowNames();
-		for (const FName& RowName : RowNames)
-		{
-			FEnemySpawnEntry* Entry = SpawnConfigTable->FindRow<FEnemySpawnEntry>(RowName, TEXT(""));
-			if (Entry)
-			{
-				bool bUnlocked = ElapsedMinutes >= Entry->MinuteUnlock;
-				bool bDeprecated = Entry->MinuteDeprecate > 0.0f && ElapsedMinutes >= Entry->MinuteDeprecate;
-
-				if (bUnlocked && !bDeprecated)
-				{
-					if (ActiveTypes.Len() > 0) ActiveTypes += TEXT(", ");
-					ActiveTypes += Entry->EnemyRowName.ToString();
-				}
-				else if (bUnlocked && bDeprecated)
-				{
-					// Show deprecated with strikethrough-ish
-				}
-
-				if (bUnlocked && UnlockedTypes.Len() == 0)
-				{
-					UnlockedTypes = Entry->EnemyRowName.ToString();
-				}
-				else if (bUnlocked)
-				{
-					UnlockedTypes = Entry->EnemyRowName.ToString();  // Keep updating to get latest
-				}
-			}
-		}
-	}
-	else if (EnemyDataTable)
-	{
-		TArray<FName> RowNames = EnemyDataTable->GetRowNames();
-		if (RowNames.Num() > 0)
-		{
-			ActiveTypes = RowNames[0].ToString();
-		}
+		if (ActiveTypes.Len() > 0) ActiveTypes += TEXT(", ");
+		ActiveTypes += Archetypes[ArchetypeIndex].RowName.ToString();
 	}
 
 	bool bAtCap = CurrentCount >= MaxEnemiesOnMap;
@@ -501,8 +1066,8 @@ void UEnemySpawnSubsystem::UpdateDebugHUD()
 	GEngine->AddOnScreenDebugMessage(102, 0.5f, bAtCap ? FColor::Red : FColor::Green,
 		FString::Printf(TEXT("Enemies: %d / %d %s"), CurrentCount, MaxEnemiesOnMap, bAtCap ? TEXT("[AT CAP]") : TEXT("")));
 
-	GEngine->AddOnScreenDebugMessage(103, 0.5f, FColor::White,
-		FString::Printf(TEXT("Pool: %d available"), EnemyPool.Num()));
+	GEngine->AddOnScreenDebugMessage(103, 0.5f, NumPoolSyncSpawns > 0 ? FColor::Orange : FColor::White,
+		FString::Printf(TEXT("Pool: %d available (want %d) | Sync Spawns: %d"), EnemyPool.Num(), GetDesiredPoolHeadroom(), NumPoolSyncSpawns));
 
 	GEngine->AddOnScreenDebugMessage(104, 0.5f, FColor::Yellow,
 		FString::Printf(TEXT("Spawn Rate: %.1f/min (%.2f/sec)"), TotalRate, SpawnsPerSecond));
@@ -515,4 +1080,13 @@ void UEnemySpawnSubsystem::UpdateDebugHUD()
 
 	GEngine->AddOnScreenDebugMessage(107, 0.5f, FColor::Cyan,
 		FString::Printf(TEXT("Active Types: %s"), ActiveTypes.Len() > 0 ? *ActiveTypes : TEXT("(none)")));
+
+	GEngine->AddOnScreenDebugMessage(108, 0.5f, NumSyncLoads > 0 ? FColor::Red : FColor::White,
+		FString::Printf(TEXT("Sync Loads: %d | Streamed Types: %d"), NumSyncLoads, EnemyAssetHandles.Num()));
+
+	const FString WaveText = WaveInterval > 0.0f
+		? FString::Printf(TEXT("Waves: %d (next in %.0fs)"), NumWaves, WaveInterval - WaveTimer)
+		: FString(TEXT("Waves: off"));
+	GEngine->AddOnScreenDebugMessage(109, 0.5f, Bursts.Num() > 0 ? FColor::Orange : FColor::White,
+		FString::Printf(TEXT("%s | Burst Queued: %d | Credit: %.2f"), *WaveText, GetPendingBurstSpawns(), SpawnCredit));
 }
@@ -3,6 +3,12 @@
 #include "CoreMinimal.h"
 #include "Subsystems/WorldSubsystem.h"
 #include "Engine/DataTable.h"
+#include "Engine/StreamableManager.h"
+#include "HordeStats.h"
+#include "EnemyArchetype.h"
+#include "EnemyHandle.h"
+#include "AliasTable.h"
+#include "XPGemSubsystem.h"
 #include "EnemySpawnSubsystem.generated.h"
 
 class ASurvivorEnemy;
@@ -37,9 +43,18 @@ public:
 
 /**
  * WorldSubsystem that manages enemy spawning and pooling.
+ *
+ * Spawning is a per-frame batch: the trickle rate accrues fractional spawn credit every
+ * tick, bursts (SpawnBurst, periodic waves) accrue their own, and whatever is due goes out
+ * together - types and locations picked for the whole batch - up to MaxSpawnsPerFrame.
+ *
+ * Ticks to grow the enemy pool in the background: each frame it spawns inactive enemies
+ * until the pool holds enough headroom for the projected demand, stopping once
+ * PoolGrowthBudgetMs is spent. Spawning only falls back to a synchronous SpawnActor
+ * when that headroom runs out (counted in STAT_EnemyPoolSyncSpawns and the debug HUD).
  */
 UCLASS()
-class FIRSTHORDESURVIVOR_API UEnemySpawnSubsystem : public UWorldSubsystem
+class FIRSTHORDESURVIVOR_API UEnemySpawnSubsystem : public UTickableWorldSubsystem
 {
 	GENERATED_BODY()
 
@@ -49,17 +64,69 @@ public:
 	virtual void Deinitialize() override;
 	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
 
+	// FTickableGameObject interface
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
 	// Pool management
 	ASurvivorEnemy* GetEnemyFromPool();
 	void ReturnEnemyToPool(ASurvivorEnemy* Enemy);
 
-	// Called by enemies on death
+	// Called by enemies on death. Cheap: the enemy leaves the active set (its handles go stale)
+	// and is queued; gems and the pool return happen in one batch per frame (ProcessDeaths).
 	void OnEnemyDeath(ASurvivorEnemy* Enemy);
 
+	// Enemies currently alive on the map (not pooled), packed; order changes on every removal
+	const TArray<ASurvivorEnemy*>& GetActiveEnemies() const { return ActiveEnemies; }
+
+	// Handle to an active enemy (unset if the enemy is pooled or unknown)
+	FEnemyHandle GetEnemyHandle(const ASurvivorEnemy* Enemy) const;
+
+	// The active enemy a handle refers to, or nullptr if it died or was pooled since the handle was taken
+	ASurvivorEnemy* ResolveEnemy(FEnemyHandle Handle) const;
+	bool IsHandleValid(FEnemyHandle Handle) const { return ResolveEnemy(Handle) != nullptr; }
+
+	// Track a level-placed enemy as active (gives it a pool slot and a handle)
+	void AdoptEnemy(ASurvivorEnemy* Enemy);
+
+	// Number of stable pool slots handed out (every enemy actor ever created, pooled or not)
+	int32 GetNumPoolSlots() const { return SlotEnemies.Num(); }
+
+	// Resolve an enemy asset that should already be resident (streamed ahead of its unlock).
+	// Falls back to a synchronous load, which is counted in STAT_EnemySyncLoads and the debug HUD.
+	template<typename T>
+	T* ResolveEnemyAsset(const TSoftObjectPtr<T>& Asset);
+
+	// Are the mesh and material of this archetype loaded?
+	bool AreArchetypeAssetsResident(int32 ArchetypeIndex) const;
+
+	// Compiled enemy types. Indices are stable until the tables are rebuilt.
+	const FEnemyArchetype* GetArchetype(int32 ArchetypeIndex) const { return Archetypes.IsValidIndex(ArchetypeIndex) ? &Archetypes[ArchetypeIndex] : nullptr; }
+
+	// Archetype for a row (level-placed enemies may use a table other than EnemyDataTable; it is compiled on demand)
+	int32 FindOrAddArchetype(UDataTable* DataTable, FName RowName);
+
+	// Fill in mesh/material once resident (sync-loads through ResolveEnemyAsset otherwise)
+	void ResolveArchetypeAssets(int32 ArchetypeIndex);
+
+	// Recompile archetypes and the spawn timeline; live enemies are re-pointed by row name
+	void RebuildArchetypes();
+
+	// LevelFloor brush bounds cached on Configure. Returns false if no floor was found.
+	bool GetFloorBounds(FBox& OutBounds) const { OutBounds = FloorBounds; return bHasFloorBounds; }
+
 	// Start/stop spawning
 	void StartSpawning();
 	void StopSpawning();
 
+	// Queue Count extra spawns on top of the trickle rate, spread evenly over Duration seconds
+	// (0 = as fast as MaxSpawnsPerFrame allows). Still subject to MaxEnemiesOnMap.
+	UFUNCTION(BlueprintCallable, Category = "Spawning")
+	void SpawnBurst(int32 Count, float Duration = 0.0f);
+
+	// Burst spawns queued but not yet delivered
+	int32 GetPendingBurstSpawns() const;
+
 	// Configuration helper (call from GameMode or Level Blueprint)
 	UFUNCTION(BlueprintCallable, Category = "Config")
 	void Configure(TSubclassOf<ASurvivorEnemy> InEnemyClass, UDataTable* InEnemyDataTable, UDataTable* InSpawnConfigTable);
@@ -100,12 +167,38 @@ public:
 	UPROPERTY(EditAnywhere, Category = "Spawn Rate")
 	float Responsiveness = 0.9f;  // 0-1, how aggressively to spawn when empty
 
+	UPROPERTY(EditAnywhere, Category = "Spawn Rate", meta = (ClampMin = "1"))
+	int32 MaxSpawnsPerFrame = 8;  // Trickle + burst spawns per frame; the rest waits for the next frame
+
+	// Waves (bursts layered on the trickle rate)
+	UPROPERTY(EditAnywhere, Category = "Waves", meta = (ClampMin = "0.0"))
+	float WaveInterval = 0.0f;  // Seconds between waves (0 = no waves)
+
+	UPROPERTY(EditAnywhere, Category = "Waves", meta = (ClampMin = "0"))
+	int32 WaveBaseSize = 20;  // Enemies in a wave at game start
+
+	UPROPERTY(EditAnywhere, Category = "Waves", meta = (ClampMin = "0.0"))
+	float WaveSizeGrowth = 10.0f;  // Extra wave enemies per minute elapsed
+
+	UPROPERTY(EditAnywhere, Category = "Waves", meta = (ClampMin = "0.0"))
+	float WaveDuration = 3.0f;  // Seconds over which a wave arrives
+
 	// Caps
 	UPROPERTY(EditAnywhere, Category = "Limits")
 	int32 MaxEnemiesOnMap = 350;  // Performance cap
 
 	UPROPERTY(EditAnywhere, Category = "Limits")
-	int32 PreWarmCount = 20;  // Enemies to pre-spawn inactive
+	int32 PreWarmCount = 20;  // Enemies to pre-spawn inactive (grown over several frames)
+
+	// Pool Growth
+	UPROPERTY(EditAnywhere, Category = "Pool Growth", meta = (ClampMin = "0.1"))
+	float PoolGrowthBudgetMs = 1.0f;  // Game thread time per frame for spawning pooled enemies (at least one spawn per frame)
+
+	UPROPERTY(EditAnywhere, Category = "Pool Growth", meta = (ClampMin = "0.0"))
+	float PoolHeadroomSeconds = 3.0f;  // Keep enough inactive enemies for this many seconds at the current spawn rate
+
+	UPROPERTY(EditAnywhere, Category = "Pool Growth", meta = (ClampMin = "0"))
+	int32 MinPoolHeadroom = 10;  // Never aim for fewer inactive enemies than this
 
 	// Spawn Location
 	UPROPERTY(EditAnywhere, Category = "Location")
@@ -117,6 +210,29 @@ public:
 	UPROPERTY(EditAnywhere, Category = "Location")
 	float FloorBoundsMargin = 200.0f;  // Safety margin inside floor bounds
 
+	// Asset Streaming
+	UPROPERTY(EditAnywhere, Category = "Streaming")
+	float AssetLookaheadSeconds = 30.0f;  // Start async loading enemy types this long before they unlock
+
+	UPROPERTY(EditAnywhere, Category = "Streaming")
+	float StreamingCheckInterval = 1.0f;  // Seconds between spawn timeline look-ahead checks
+
+	// Simulation LOD (read by UHordeSimulationSubsystem every step)
+	UPROPERTY(EditAnywhere, Category = "Simulation LOD")
+	bool bEnableSimulationLOD = true;
+
+	UPROPERTY(EditAnywhere, Category = "Simulation LOD")
+	float LODFrustumMargin = 150.0f;  // Sphere radius for the on-screen test (keeps edge enemies full rate)
+
+	UPROPERTY(EditAnywhere, Category = "Simulation LOD")
+	float LODFarDistance = 2200.0f;  // Offscreen enemies beyond this from the player use the far interval
+
+	UPROPERTY(EditAnywhere, Category = "Simulation LOD", meta = (ClampMin = "1"))
+	int32 LODNearOffscreenInterval = 2;  // Offscreen: full update every Nth frame
+
+	UPROPERTY(EditAnywhere, Category = "Simulation LOD", meta = (ClampMin = "1"))
+	int32 LODFarOffscreenInterval = 4;  // Far offscreen: full update every Nth frame
+
 	// Debug
 	UPROPERTY(EditAnywhere, Category = "Debug")
 	bool bShowDebugHUD = true;
@@ -130,23 +246,148 @@ protected:
 	UPROPERTY()
 	TArray<ASurvivorEnemy*> EnemyPool;
 
+	// Packed; each enemy's ActiveIndex is its position here (swap-remove on return)
 	UPROPERTY()
 	TArray<ASurvivorEnemy*> ActiveEnemies;
 
-	// Spawn timer
-	FTimerHandle SpawnTimerHandle;
+	// Indexed by pool slot (FEnemyHandle::Index). Generations are odd while the enemy is
+	// active and even while it is pooled, so handles taken before a death never resolve.
+	UPROPERTY()
+	TArray<ASurvivorEnemy*> SlotEnemies;
+
+	TArray<uint32> SlotGenerations;
+
+	// Fractional trickle spawns carried between frames
+	float SpawnCredit = 0.0f;
+
+	// Queued bursts, served oldest first
+	struct FSpawnBurst
+	{
+		int32 Remaining;
+		float PerSecond;  // 0 = all at once (budget permitting)
+		float Credit;
+	};
+	TArray<FSpawnBurst> Bursts;
+
+	float WaveTimer = 0.0f;
+	int32 NumWaves = 0;
+	float DebugHUDTimer = 0.0f;
+
+	// Per-batch scratch (types and locations for every spawn this frame)
+	TArray<int32> BatchArchetypes;
+	TArray<FVector> BatchLocations;
+
+	// Deaths since the last batch (ProcessDeaths, every tick)
+	struct FPendingDeath
+	{
+		ASurvivorEnemy* Enemy;
+		int32 Archetype;
+		FVector Location;
+	};
+	TArray<FPendingDeath> PendingDeaths;
+	TArray<FGemSpawnRequest> GemRequests;  // Reused between batches
+
+	// Pool growth runs between StartSpawning and StopSpawning
+	bool bIsSpawning = false;
+	int32 NumPoolSyncSpawns = 0;
+
+	// Compiled from EnemyDataTable (first, in row order) plus on-demand rows from other tables
+	UPROPERTY()
+	TArray<FEnemyArchetype> Archetypes;
+
+	TMap<TPair<const UDataTable*, FName>, int32> ArchetypeLookup;
+
+	// DT_EnemySpawns compiled against Archetypes (rows with unknown enemies are dropped)
+	struct FCompiledSpawnEntry
+	{
+		int32 Archetype;
+		float Weight;
+		float MinuteUnlock;
+		float MinuteDeprecate;  // 0 = never
+	};
+	TArray<FCompiledSpawnEntry> SpawnEntries;
+
+	// Sorted, unique minutes at which some entry unlocks or deprecates. Between two of these
+	// the set of spawnable types cannot change (except when assets finish streaming in).
+	TArray<float> SpawnTimeline;
+
+	// Spawnable right now (unlocked, not deprecated, assets resident): archetype per alias column
+	TArray<int32> ActiveSpawnArchetypes;
+	TArray<float> ActiveSpawnWeights;
+	FAliasTable ActiveSpawnTable;
+
+	// Timeline window [Start, End) the active set was built for
+	float ActiveSetStartMinute = 0.0f;
+	float ActiveSetEndMinute = -1.0f;
+	bool bActiveSetDirty = true;  // Tables rebuilt or an enemy type finished streaming
+
+	// Tables we listen to for hot reload
+	TArray<TWeakObjectPtr<UDataTable>> WatchedTables;
+	bool bArchetypesBuilt = false;
+
+	// Asset streaming: one handle per enemy row, kept alive while the type can spawn
+	FStreamableManager StreamableManager;
+	TMap<int32, TSharedPtr<FStreamableHandle>> EnemyAssetHandles;  // Keyed by archetype index
+	FTimerHandle StreamingTimerHandle;
+	int32 NumSyncLoads = 0;
 
 	// Track if configured
 	bool bIsConfigured = false;
 
 	// Internal functions
-	void PreWarmPool(int32 Count);
-	void SpawnEnemy();
-	FVector GetSpawnLocation();
-	FName SelectEnemyType();
+	// Inactive enemies the pool should hold right now (projected demand, capped by MaxEnemiesOnMap)
+	int32 GetDesiredPoolHeadroom();
+	void GrowPool();
+	void ProcessDeaths();
+	ASurvivorEnemy* SpawnPooledEnemy();
+
+	// Every enemy actor gets a stable pool slot for its lifetime (dense, starting at 0).
+	// Used to index compact per-enemy bitmasks and as the handle index.
+	int32 AllocatePoolSlot(ASurvivorEnemy* Enemy);
+
+	// Add to / swap-remove from ActiveEnemies, advancing the slot generation
+	void ActivateEnemy(ASurvivorEnemy* Enemy);
+	void DeactivateEnemy(ASurvivorEnemy* Enemy);
+
+	// Accrue trickle/burst credit and spawn whatever is due this frame
+	void UpdateSpawning(float DeltaTime);
+
+	// Returns how many were actually spawned (fewer if no type is ready or the pool fails)
+	int32 SpawnBatch(int32 Count);
+	void GetSpawnLocations(int32 Count, TArray<FVector>& OutLocations);
+	bool SelectEnemyArchetypes(int32 Count, TArray<int32>& OutArchetypes);
+
+	// Rebuild the active set and alias table if ElapsedMinutes left the current timeline window
+	void RefreshActiveSpawnSet(float ElapsedMinutes);
+	void OnEnemyAssetsLoaded();
 	float GetCurrentSpawnRate();
 	float GetCurrentTargetCount();
 	void LoadDefaultAssets();
+	void UpdateAssetStreaming();
+	void RequestEnemyAssets(int32 ArchetypeIndex);
+	int32 AddArchetype(const UDataTable* DataTable, FName RowName, const FEnemyTableRow& Row);
+	void WatchTable(UDataTable* Table);
+	void UnwatchTables();
+	void OnTableChanged();
 	void CacheFloorBounds();
 	FVector ClampToFloorBounds(FVector Location);
 };
+
+template<typename T>
+T* UEnemySpawnSubsystem::ResolveEnemyAsset(const TSoftObjectPtr<T>& Asset)
+{
+	if (T* Loaded = Asset.Get())
+	{
+		return Loaded;
+	}
+	if (Asset.IsNull())
+	{
+		return nullptr;
+	}
+
+	// Streaming missed this one (level-placed enemy, or selected before it was resident)
+	INC_DWORD_STAT(STAT_EnemySyncLoads);
+	NumSyncLoads++;
+	UE_LOG(LogTemp, Warning, TEXT("EnemySpawnSubsystem: synchronous load of %s"), *Asset.ToString());
+	return Asset.LoadSynchronous();
+}
@@ -0,0 +1,154 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Shared enemy tuning constants.
+// Used by ASurvivorEnemy (per-enemy queries such as knockback resistance) and
+// UHordeSimulationSubsystem (the batched per-frame horde step).
+
+// Enemy separation tuning constants
+namespace SeparationSettings
+{
+	// Radius within which we push away from other enemies
+	constexpr float SeparationRadius = 150.0f;
+
+	// Max speed added by separation force (units/sec) — gentle, just prevents full overlap
+	constexpr float MaxSeparationSpeed = 400.0f;
+}
+
+// Knockback tuning constants
+namespace KnockbackSettings
+{
+	// How fast knockback decays (units/sec lost per second)
+	constexpr float FrictionDeceleration = 1000.0f;
+
+	// Minimum velocity before knockback stops entirely
+	constexpr float MinVelocityThreshold = 50.0f;
+
+	// How much momentum the pusher retains after hitting another enemy (0.5 = 50%)
+	constexpr float PusherMomentumRetention = 0.9f;
+
+	// How much of the pusher's momentum transfers to the pushed enemy
+	constexpr float MomentumTransferRatio = 0.95f;
+
+	// Radius to check for enemy collisions during knockback
+	constexpr float CollisionCheckRadius = 80.0f;
+
+	// Body radius added to CollisionCheckRadius for the center-to-center contact test
+	// (the old sphere-vs-capsule overlap reached the capsule edge; default capsule radius is 34)
+	constexpr float EnemyBodyRadius = 34.0f;
+
+	// === Initial knockback scaling by enemy HP ===
+
+	// HP at or below this gets full knockback (100%)
+	constexpr float LightEnemyHP = 20.0f;
+
+	// HP at or above this gets minimum knockback
+	constexpr float HeavyEnemyHP = 500.0f;
+
+	// Minimum knockback multiplier for heavy enemies (10% = 0.1)
+	constexpr float MinKnockbackMultiplier = 0.1f;
+
+	// Knockback multiplier for an enemy with this max HP (lighter enemies get knocked back more)
+	inline float GetResistanceForHealth(float MaxHP)
+	{
+		// Below light threshold: full knockback
+		if (MaxHP <= LightEnemyHP)
+		{
+			return 1.0f;
+		}
+
+		// Above heavy threshold: minimum knockback
+		if (MaxHP >= HeavyEnemyHP)
+		{
+			return MinKnockbackMultiplier;
+		}
+
+		// Linear interpolation between light and heavy
+		const float Alpha = (MaxHP - LightEnemyHP) / (HeavyEnemyHP - LightEnemyHP);
+		return FMath::Lerp(1.0f, MinKnockbackMultiplier, Alpha);
+	}
+}
+
+// Crowd push tuning — enemies behind shove enemies in front toward the player
+namespace CrowdPushSettings
+{
+	// Extra speed (units/sec) a fully-adjacent trailing enemy adds to the front enemy
+	constexpr float MaxPushSpeed = 350.0f;
+
+	// How fast push velocity decays when no longer being pushed (units/sec lost per sec)
+	constexpr float PushDecay = 600.0f;
+}
+
+// Orbital approach tuning
+namespace OrbitSettings
+{
+	// Distance at which enemies stop pushing toward the player.
+	// Should be slightly less than ContactDamageSettings::AttackRadius so they're in attack range.
+	constexpr float OrbitRadius = 120.0f;
+}
+
+// Contact damage (UHordeSimulationSubsystem::ResolveContactDamage)
+namespace ContactDamageSettings
+{
+	// Reach from the enemy center; added to the player's capsule radius
+	// (matches the old 150-radius per-enemy attack sphere)
+	constexpr float AttackRadius = 150.0f;
+
+	// Seconds between attacks while an enemy stays in range. Entering range attacks immediately.
+	constexpr float AttackInterval = 1.0f;
+}
+
+// Hit flash tuning
+namespace HitFlashSettings
+{
+	// Intensity lost per second once the hold period ends
+	constexpr float DecayRate = 5.0f;
+
+	// Hold at full intensity for ~5 frames at 60fps
+	constexpr float HoldDuration = 0.08f;
+}
+
+// Kinematic mover tuning (enemies with bUseKinematicMover)
+namespace KinematicMoverSettings
+{
+	// Distance kept from the floor edge (roughly a capsule radius) by enemies with bClampToFloorBounds
+	constexpr float WallMargin = 50.0f;
+}
+
+// Horde step threading
+namespace HordeParallelSettings
+{
+	// Below this many enemies the separation gather stays on the game thread
+	constexpr int32 MinParallelCount = 256;
+
+	// Enemies per worker task (each does a 3x3-cell grid walk)
+	constexpr int32 GatherBatchSize = 64;
+}
+
+// Flow field steering (UFlowFieldSubsystem)
+namespace FlowFieldSettings
+{
+	// Inside this distance enemies ignore the field and chase the player directly
+	// (the field is only cell-accurate; up close we want exact aim)
+	constexpr float DirectChaseRadius = 300.0f;
+
+	// Obstacle probe box: center height above the floor, and half height
+	constexpr float ProbeHeight = 100.0f;
+	constexpr float ProbeHalfHeight = 50.0f;
+
+	// Cells the Dijkstra pass settles per horde step after the player changes cell. A 100x100
+	// floor finishes in 3 steps; the previous field keeps steering (one cell off) meanwhile.
+	constexpr int32 CellsPerStep = 4096;
+}
+
+// XP gem drops (ASurvivorEnemy::OnDeath, decomposition precomputed per FEnemyArchetype)
+namespace GemSettings
+{
+	// Gem values, largest first: XP is paid out greedily in the fewest gems
+	constexpr int32 Tiers[] = { 100, 50, 20, 5, 1 };
+	constexpr int32 NumTiers = UE_ARRAY_COUNT(Tiers);
+
+	// Random scatter around the death location
+	constexpr float ScatterRadius = 50.0f;
+}
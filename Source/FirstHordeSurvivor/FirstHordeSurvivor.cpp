@@ -2,5 +2,14 @@
 
 #include "FirstHordeSurvivor.h"
 #include "Modules/ModuleManager.h"
+#include "HordeStats.h"
+
+DEFINE_STAT(STAT_EnemySyncLoads);
+DEFINE_STAT(STAT_EnemyTypesStreaming);
+DEFINE_STAT(STAT_EnemyPoolSyncSpawns);
+DEFINE_STAT(STAT_OverlapPairs);
+DEFINE_STAT(STAT_ProjectilePoolHits);
+DEFINE_STAT(STAT_ProjectilePoolMisses);
+DEFINE_STAT(STAT_SimulatedProjectiles);
 
 IMPLEMENT_PRIMARY_GAME_MODULE( FDefaultGameModuleImpl, FirstHordeSurvivor, "FirstHordeSurvivor" );
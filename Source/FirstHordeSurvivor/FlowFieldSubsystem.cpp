@@ -0,0 +1,257 @@
+#include "FlowFieldSubsystem.h"
+#include "EnemySpawnSubsystem.h"
+#include "EnemyTuning.h"
+#include "Engine/World.h"
+
+namespace
+{
+	// 8-connected neighborhood: orthogonal steps first, then diagonals
+	constexpr int32 NeighborDX[8] = { 1, -1, 0, 0, 1, 1, -1, -1 };
+	constexpr int32 NeighborDY[8] = { 0, 0, 1, -1, 1, -1, 1, -1 };
+
+	// Integer step costs (~10 * length) keep the integration exact and cheap
+	constexpr uint32 OrthogonalCost = 10;
+	constexpr uint32 DiagonalCost = 14;
+	constexpr uint32 Unreachable = MAX_uint32;
+
+	struct FCheaperFirst
+	{
+		template<typename EntryType>
+		bool operator()(const EntryType& A, const EntryType& B) const { return A.Cost < B.Cost; }
+	};
+}
+
+void UFlowFieldSubsystem::Deinitialize()
+{
+	Blocked.Empty();
+	Costs.Empty();
+	Directions.Empty();
+	PendingDirections.Empty();
+	OpenList.Empty();
+
+	Super::Deinitialize();
+}
+
+bool UFlowFieldSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	// Only create for game worlds, not editor preview
+	UWorld* World = Cast<UWorld>(Outer);
+	return World && World->IsGameWorld();
+}
+
+void UFlowFieldSubsystem::UpdateGoal(const FVector& GoalLocation)
+{
+	// Prefer the LevelFloor once the spawner has found it (it is cached on StartSpawning)
+	bool bFloorAvailable = false;
+	if (UEnemySpawnSubsystem* SpawnSubsystem = GetWorld()->GetSubsystem<UEnemySpawnSubsystem>())
+	{
+		FBox FloorBounds;
+		bFloorAvailable = SpawnSubsystem->GetFloorBounds(FloorBounds);
+	}
+
+	bool bNeedsLayout = !bHasLayout || (bFloorAvailable && !bUsingFloorBounds);
+	if (bHasLayout && !bUsingFloorBounds)
+	{
+		// Fallback window: re-center once the goal leaves the middle half
+		const float Extent = NumX * CellSize;
+		const FVector2f Local = FVector2f((float)GoalLocation.X, (float)GoalLocation.Y) - Origin;
+		bNeedsLayout |= Local.X < Extent * 0.25f || Local.X > Extent * 0.75f
+			|| Local.Y < Extent * 0.25f || Local.Y > Extent * 0.75f;
+	}
+
+	if (bNeedsLayout)
+	{
+		RebuildLayout(GoalLocation);
+	}
+
+	if (bObstaclesDirty)
+	{
+		RebuildObstacles();
+	}
+
+	// Goals outside the field (player off the floor) snap to the nearest edge cell
+	const int32 GoalX = FMath::Clamp(FMath::FloorToInt32(((float)GoalLocation.X - Origin.X) / CellSize), 0, NumX - 1);
+	const int32 GoalY = FMath::Clamp(FMath::FloorToInt32(((float)GoalLocation.Y - Origin.Y) / CellSize), 0, NumY - 1);
+	const int32 NewGoalCell = GoalY * NumX + GoalX;
+
+	if (NewGoalCell != GoalCell)
+	{
+		// The current field keeps steering toward the old cell until the new one is complete
+		GoalCell = NewGoalCell;
+		BeginIntegration();
+	}
+
+	if (bIntegrating)
+	{
+		// Nothing to fall back on after a layout/obstacle rebuild: finish right away
+		StepIntegration(bHasField ? FlowFieldSettings::CellsPerStep : MAX_int32);
+	}
+}
+
+FVector2f UFlowFieldSubsystem::GetDirection(const FVector& Location) const
+{
+	const int32 Cell = ToCellIndex(Location);
+	return Cell != INDEX_NONE && Directions.IsValidIndex(Cell) ? Directions[Cell] : FVector2f::ZeroVector;
+}
+
+int32 UFlowFieldSubsystem::ToCellIndex(const FVector& Location) const
+{
+	const int32 CellX = FMath::FloorToInt32(((float)Location.X - Origin.X) / CellSize);
+	const int32 CellY = FMath::FloorToInt32(((float)Location.Y - Origin.Y) / CellSize);
+	if (CellX < 0 || CellX >= NumX || CellY < 0 || CellY >= NumY)
+	{
+		return INDEX_NONE;
+	}
+	return CellY * NumX + CellX;
+}
+
+FVector2f UFlowFieldSubsystem::GetCellCenter(int32 CellX, int32 CellY) const
+{
+	return Origin + FVector2f((CellX + 0.5f) * CellSize, (CellY + 0.5f) * CellSize);
+}
+
+void UFlowFieldSubsystem::RebuildLayout(const FVector& GoalLocation)
+{
+	CellSize = FMath::Max(CellSize, 10.0f);
+
+	FBox FloorBounds;
+	UEnemySpawnSubsystem* SpawnSubsystem = GetWorld()->GetSubsystem<UEnemySpawnSubsystem>();
+	bUsingFloorBounds = SpawnSubsystem && SpawnSubsystem->GetFloorBounds(FloorBounds);
+
+	if (bUsingFloorBounds)
+	{
+		Origin = FVector2f((float)FloorBounds.Min.X, (float)FloorBounds.Min.Y);
+		NumX = FMath::Max(1, FMath::CeilToInt32((float)FloorBounds.GetSize().X / CellSize));
+		NumY = FMath::Max(1, FMath::CeilToInt32((float)FloorBounds.GetSize().Y / CellSize));
+		ProbeZ = (float)FloorBounds.Max.Z + FlowFieldSettings::ProbeHeight;
+	}
+	else
+	{
+		const float Extent = FMath::Max(FallbackHalfExtent, CellSize);
+		Origin = FVector2f((float)GoalLocation.X - Extent, (float)GoalLocation.Y - Extent);
+		NumX = NumY = FMath::CeilToInt32(2.0f * Extent / CellSize);
+		ProbeZ = (float)GoalLocation.Z;
+	}
+
+	const int32 NumCells = NumX * NumY;
+	Blocked.SetNumZeroed(NumCells);
+	Costs.SetNumUninitialized(NumCells);
+	Directions.SetNumZeroed(NumCells);
+	PendingDirections.SetNumZeroed(NumCells);
+
+	bHasLayout = true;
+	bObstaclesDirty = true;
+	bHasField = false;
+	bIntegrating = false;
+	GoalCell = INDEX_NONE;
+}
+
+void UFlowFieldSubsystem::RebuildObstacles()
+{
+	UWorld* World = GetWorld();
+
+	// One box probe per cell, lifted off the floor so the floor itself never counts.
+	// Only static geometry blocks the field; pawns, gems and projectiles are ignored.
+	const FCollisionShape Probe = FCollisionShape::MakeBox(FVector(CellSize * 0.5f, CellSize * 0.5f, FlowFieldSettings::ProbeHalfHeight));
+	const FCollisionObjectQueryParams ObjectParams(ECC_WorldStatic);
+	FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(FlowFieldObstacles), false);
+
+	int32 NumBlocked = 0;
+	for (int32 CellY = 0; CellY < NumY; ++CellY)
+	{
+		for (int32 CellX = 0; CellX < NumX; ++CellX)
+		{
+			const FVector2f Center = GetCellCenter(CellX, CellY);
+			const bool bBlocked = World->OverlapAnyTestByObjectType(
+				FVector(Center.X, Center.Y, ProbeZ), FQuat::Identity, ObjectParams, Probe, QueryParams);
+			Blocked[CellY * NumX + CellX] = bBlocked;
+			NumBlocked += bBlocked ? 1 : 0;
+		}
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("FlowField: %dx%d cells (%.0f uu), %d blocked"), NumX, NumY, CellSize, NumBlocked);
+
+	bObstaclesDirty = false;
+	bHasField = false;
+	bIntegrating = false;
+	GoalCell = INDEX_NONE;
+}
+
+bool UFlowFieldSubsystem::CanStep(int32 X, int32 Y, int32 DX, int32 DY) const
+{
+	const int32 NX = X + DX;
+	const int32 NY = Y + DY;
+	if (NX < 0 || NX >= NumX || NY < 0 || NY >= NumY || Blocked[NY * NumX + NX])
+	{
+		return false;
+	}
+	return DX == 0 || DY == 0 || (!Blocked[Y * NumX + NX] && !Blocked[NY * NumX + X]);
+}
+
+void UFlowFieldSubsystem::BeginIntegration()
+{
+	const int32 NumCells = NumX * NumY;
+	for (int32 Cell = 0; Cell < NumCells; ++Cell)
+	{
+		Costs[Cell] = Unreachable;
+	}
+	FMemory::Memzero(PendingDirections.GetData(), NumCells * sizeof(FVector2f));
+
+	// Dijkstra from the goal outward. Lazy deletion: stale heap entries are skipped.
+	OpenList.Reset();
+	Costs[GoalCell] = 0;
+	OpenList.HeapPush({ 0, GoalCell }, FCheaperFirst());
+	bIntegrating = true;
+}
+
+void UFlowFieldSubsystem::StepIntegration(int32 MaxCells)
+{
+	int32 NumSettled = 0;
+	while (OpenList.Num() > 0 && NumSettled < MaxCells)
+	{
+		FOpenEntry Entry;
+		OpenList.HeapPop(Entry, FCheaperFirst(), EAllowShrinking::No);
+		if (Entry.Cost != Costs[Entry.Cell])
+		{
+			continue;
+		}
+		++NumSettled;
+
+		const int32 X = Entry.Cell % NumX;
+		const int32 Y = Entry.Cell / NumX;
+		uint32 BestCost = Entry.Cost;
+		for (int32 Dir = 0; Dir < 8; ++Dir)
+		{
+			if (!CanStep(X, Y, NeighborDX[Dir], NeighborDY[Dir]))
+			{
+				continue;
+			}
+
+			const int32 Neighbor = (Y + NeighborDY[Dir]) * NumX + (X + NeighborDX[Dir]);
+			const uint32 NeighborCost = Costs[Neighbor];
+
+			// Settled in cost order, so every neighbor cheaper than this cell is already final:
+			// point at the cheapest one now instead of in a separate pass over the grid
+			if (NeighborCost < BestCost)
+			{
+				BestCost = NeighborCost;
+				PendingDirections[Entry.Cell] = FVector2f((float)NeighborDX[Dir], (float)NeighborDY[Dir]).GetSafeNormal();
+			}
+
+			const uint32 NewCost = Entry.Cost + (Dir < 4 ? OrthogonalCost : DiagonalCost);
+			if (NewCost < NeighborCost)
+			{
+				Costs[Neighbor] = NewCost;
+				OpenList.HeapPush({ NewCost, Neighbor }, FCheaperFirst());
+			}
+		}
+	}
+
+	if (OpenList.Num() == 0)
+	{
+		// Unreached cells kept their zero direction
+		Swap(Directions, PendingDirections);
+		bIntegrating = false;
+		bHasField = true;
+	}
+}
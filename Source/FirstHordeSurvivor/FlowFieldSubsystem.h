@@ -0,0 +1,95 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "FlowFieldSubsystem.generated.h"
+
+/**
+ * WorldSubsystem holding one shared flow field toward the player.
+ *
+ * The arena (LevelFloor bounds, or a window around the player if there is no floor)
+ * is split into cells. Cells overlapping static geometry are marked blocked once;
+ * a Dijkstra integration pass from the player's cell then gives every open cell a
+ * direction toward its cheapest neighbor. Enemies steer with one O(1) lookup.
+ *
+ * Driven by UHordeSimulationSubsystem: UpdateGoal runs every step but only
+ * recomputes when the player enters a different cell. The recompute is spread over
+ * steps (FlowFieldSettings::CellsPerStep settled cells each, persistent open list) into
+ * a back buffer, and the finished field is swapped in; until then enemies keep following
+ * the previous field, which is at most a cell or so off.
+ */
+UCLASS()
+class FIRSTHORDESURVIVOR_API UFlowFieldSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// USubsystem interface
+	virtual void Deinitialize() override;
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+
+	// Point the field at the goal. Cheap unless the goal changed cells (or obstacles are dirty).
+	void UpdateGoal(const FVector& GoalLocation);
+
+	// Re-probe obstacles on the next UpdateGoal (call after moving level elements)
+	void InvalidateObstacles() { bObstaclesDirty = true; }
+
+	// Unit XY steering direction at Location. Zero outside the field, in blocked or
+	// unreachable cells, in the goal cell, and before the first field is complete —
+	// callers then steer straight at the goal.
+	FVector2f GetDirection(const FVector& Location) const;
+
+	// Cell edge length. Larger = cheaper rebuilds, coarser paths around obstacles.
+	UPROPERTY(EditAnywhere, Category = "Flow Field")
+	float CellSize = 200.0f;
+
+	// Half size of the field window used when the level has no LevelFloor brush
+	UPROPERTY(EditAnywhere, Category = "Flow Field")
+	float FallbackHalfExtent = 6000.0f;
+
+protected:
+	void RebuildLayout(const FVector& GoalLocation);
+	void RebuildObstacles();
+	// Restart the integration toward GoalCell (resets the back buffer and open list)
+	void BeginIntegration();
+
+	// Settle up to MaxCells cells; swaps the finished field in once the open list drains
+	void StepIntegration(int32 MaxCells);
+
+	// Can we step from (X, Y) by (DX, DY)? Diagonals may not cut blocked corners.
+	bool CanStep(int32 X, int32 Y, int32 DX, int32 DY) const;
+
+	// INDEX_NONE if Location is outside the field
+	int32 ToCellIndex(const FVector& Location) const;
+	FVector2f GetCellCenter(int32 CellX, int32 CellY) const;
+
+	// Field layout
+	FVector2f Origin = FVector2f::ZeroVector;
+	int32 NumX = 0;
+	int32 NumY = 0;
+	float ProbeZ = 0.0f;
+	bool bHasLayout = false;
+	bool bUsingFloorBounds = false;
+	bool bObstaclesDirty = true;
+
+	// Per cell, row-major (Y * NumX + X)
+	TArray<bool> Blocked;
+	TArray<uint32> Costs;                 // Integration in progress
+	TArray<FVector2f> Directions;         // Field enemies read (GetDirection)
+	TArray<FVector2f> PendingDirections;  // Filled as cells are settled, swapped in when complete
+
+	// Goal of the integration in progress (or of the current field once it is done)
+	int32 GoalCell = INDEX_NONE;
+	bool bIntegrating = false;
+
+	// Directions holds a complete field for the current layout and obstacles
+	bool bHasField = false;
+
+	// Dijkstra open list; persists across steps while an integration is spread out
+	struct FOpenEntry
+	{
+		uint32 Cost;
+		int32 Cell;
+	};
+	TArray<FOpenEntry> OpenList;
+};
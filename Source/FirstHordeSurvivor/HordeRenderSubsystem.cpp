@@ -0,0 +1,212 @@
+#include "HordeRenderSubsystem.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Materials/MaterialInstanceDynamic.h"
+#include "EnemyArchetype.h"
+#include "Engine/World.h"
+
+void UHordeRenderSubsystem::Deinitialize()
+{
+	HostActor = nullptr;
+	BatchComponents.Empty();
+	Batches.Empty();
+	BatchLookup.Empty();
+	SharedMaterials.Empty();
+
+	Super::Deinitialize();
+}
+
+bool UHordeRenderSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	// Only create for game worlds, not editor preview
+	UWorld* World = Cast<UWorld>(Outer);
+	return World && World->IsGameWorld();
+}
+
+int32 UHordeRenderSubsystem::FindOrCreateBatch(UStaticMesh* Mesh, UMaterialInterface* Material)
+{
+	const TPair<UStaticMesh*, UMaterialInterface*> Key(Mesh, Material);
+	if (const int32* Existing = BatchLookup.Find(Key))
+	{
+		return *Existing;
+	}
+
+	if (!HostActor)
+	{
+		FActorSpawnParameters Params;
+		Params.Name = TEXT("HordeInstanceRenderer");
+		Params.ObjectFlags |= RF_Transient;
+		HostActor = GetWorld()->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity, Params);
+	}
+
+	UInstancedStaticMeshComponent* Component = NewObject<UInstancedStaticMeshComponent>(HostActor);
+	Component->SetStaticMesh(Mesh);
+	if (Material)
+	{
+		Component->SetMaterial(0, Material);
+	}
+	Component->SetNumCustomDataFloats(EnemyCustomData::Num);
+
+	// Visual only: the enemy capsule owns collision and overlaps
+	Component->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	Component->SetGenerateOverlapEvents(false);
+	Component->SetCanEverAffectNavigation(false);
+	Component->SetMobility(EComponentMobility::Movable);
+
+	// Render to custom depth for post-process outline (same as the per-enemy mesh)
+	Component->SetRenderCustomDepth(true);
+
+	if (!HostActor->GetRootComponent())
+	{
+		HostActor->SetRootComponent(Component);
+	}
+	else
+	{
+		Component->SetupAttachment(HostActor->GetRootComponent());
+	}
+	Component->RegisterComponent();
+	HostActor->AddInstanceComponent(Component);
+
+	const int32 Batch = Batches.AddDefaulted();
+	BatchComponents.Add(Component);
+	BatchLookup.Add(Key, Batch);
+
+	UE_LOG(LogTemp, Log, TEXT("HordeRender: new instance batch %d (%s)"), Batch, *GetNameSafe(Mesh));
+	return Batch;
+}
+
+bool UHordeRenderSubsystem::AcquireInstance(UStaticMesh* Mesh, UMaterialInterface* Material, const FTransform& Transform,
+	const FLinearColor& Color, float EmissiveStrength, int32& OutBatch, int32& OutInstance)
+{
+	OutBatch = INDEX_NONE;
+	OutInstance = INDEX_NONE;
+	if (!Mesh)
+	{
+		return false;
+	}
+
+	const int32 Batch = FindOrCreateBatch(Mesh, Material);
+	FInstanceBatch& State = Batches[Batch];
+
+	// Reuse a released instance before growing the component
+	int32 Instance;
+	if (State.FreeInstances.Num() > 0)
+	{
+		Instance = State.FreeInstances.Pop(EAllowShrinking::No);
+		State.Transforms[Instance] = Transform;
+		State.bTransformsDirty = true;
+	}
+	else
+	{
+		Instance = BatchComponents[Batch]->AddInstance(Transform, true);
+		State.Transforms.Add(Transform);
+		State.CustomData.AddZeroed(EnemyCustomData::Num);
+	}
+
+	float* Data = State.CustomData.GetData() + Instance * EnemyCustomData::Num;
+	Data[EnemyCustomData::ColorR] = Color.R;
+	Data[EnemyCustomData::ColorG] = Color.G;
+	Data[EnemyCustomData::ColorB] = Color.B;
+	Data[EnemyCustomData::EmissiveStrength] = EmissiveStrength;
+	Data[EnemyCustomData::HitFlashIntensity] = 0.0f;
+	State.DirtyCustomData.Add(Instance);
+
+	OutBatch = Batch;
+	OutInstance = Instance;
+	return true;
+}
+
+void UHordeRenderSubsystem::ReleaseInstance(int32 Batch, int32 Instance)
+{
+	if (!Batches.IsValidIndex(Batch) || !Batches[Batch].Transforms.IsValidIndex(Instance))
+	{
+		return;
+	}
+
+	// Zero scale hides the instance without shifting anyone else's index
+	FInstanceBatch& State = Batches[Batch];
+	State.Transforms[Instance] = FTransform(FQuat::Identity, FVector::ZeroVector, FVector::ZeroVector);
+	State.bTransformsDirty = true;
+	State.FreeInstances.Add(Instance);
+}
+
+void UHordeRenderSubsystem::SetInstanceTransform(int32 Batch, int32 Instance, const FTransform& Transform)
+{
+	FInstanceBatch& State = Batches[Batch];
+	State.Transforms[Instance] = Transform;
+	State.bTransformsDirty = true;
+}
+
+void UHordeRenderSubsystem::SetInstanceCustomData(int32 Batch, int32 Instance, int32 DataIndex, float Value)
+{
+	FInstanceBatch& State = Batches[Batch];
+	float& Slot = State.CustomData[Instance * EnemyCustomData::Num + DataIndex];
+	if (Slot != Value)
+	{
+		Slot = Value;
+		State.DirtyCustomData.Add(Instance);
+	}
+}
+
+void UHordeRenderSubsystem::FlushInstances()
+{
+	for (int32 Batch = 0; Batch < Batches.Num(); ++Batch)
+	{
+		FInstanceBatch& State = Batches[Batch];
+		UInstancedStaticMeshComponent* Component = BatchComponents[Batch];
+		if (!Component)
+		{
+			continue;
+		}
+
+		const bool bCustomDataDirty = State.DirtyCustomData.Num() > 0;
+		for (int32 Instance : State.DirtyCustomData)
+		{
+			const TArrayView<const float> Data(State.CustomData.GetData() + Instance * EnemyCustomData::Num, EnemyCustomData::Num);
+			Component->SetCustomData(Instance, Data, false);
+		}
+		State.DirtyCustomData.Reset();
+
+		if (State.bTransformsDirty)
+		{
+			// Whole batch in one call; also marks the render state dirty for the custom data above
+			Component->BatchUpdateInstancesTransforms(0, State.Transforms, true, true, false);
+			State.bTransformsDirty = false;
+		}
+		else if (bCustomDataDirty)
+		{
+			Component->MarkRenderStateDirty();
+		}
+	}
+}
+
+UMaterialInterface* UHordeRenderSubsystem::GetSharedEnemyMaterial(int32 ArchetypeIndex, const FEnemyArchetype& Archetype)
+{
+	if (ArchetypeIndex == INDEX_NONE || !Archetype.BaseMaterial)
+	{
+		return Archetype.BaseMaterial;
+	}
+
+	if (SharedMaterials.IsValidIndex(ArchetypeIndex) && SharedMaterials[ArchetypeIndex])
+	{
+		return SharedMaterials[ArchetypeIndex];
+	}
+
+	// Created once per enemy type; owned by the subsystem so it survives enemy pool cycles
+	UMaterialInstanceDynamic* Material = UMaterialInstanceDynamic::Create(Archetype.BaseMaterial, this);
+	Material->SetVectorParameterValue(TEXT("Color"), Archetype.Color);
+	Material->SetScalarParameterValue(TEXT("EmissiveStrength"), Archetype.EmissiveStrength);
+	Material->SetScalarParameterValue(TEXT("HitFlashIntensity"), 0.0f);
+
+	if (ArchetypeIndex >= SharedMaterials.Num())
+	{
+		SharedMaterials.SetNumZeroed(ArchetypeIndex + 1);
+	}
+	SharedMaterials[ArchetypeIndex] = Material;
+	return Material;
+}
+
+void UHordeRenderSubsystem::ResetSharedEnemyMaterials()
+{
+	SharedMaterials.Reset();
+}
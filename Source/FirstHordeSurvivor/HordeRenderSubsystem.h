@@ -0,0 +1,92 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "HordeRenderSubsystem.generated.h"
+
+class UInstancedStaticMeshComponent;
+class UStaticMesh;
+class UMaterialInterface;
+class UMaterialInstanceDynamic;
+struct FEnemyArchetype;
+
+// Per-instance custom data layout (instanced enemies only). Enemy materials read these with
+// PerInstanceCustomData nodes. EnemyMeshComp enemies use plain material parameters instead.
+namespace EnemyCustomData
+{
+	constexpr int32 ColorR = 0;
+	constexpr int32 ColorG = 1;
+	constexpr int32 ColorB = 2;
+	constexpr int32 EmissiveStrength = 3;
+	constexpr int32 HitFlashIntensity = 4;
+	constexpr int32 Num = 5;
+}
+
+/**
+ * WorldSubsystem that draws enemies through one UInstancedStaticMeshComponent per
+ * (mesh, material) pair instead of one UStaticMeshComponent per enemy.
+ *
+ * Instances are pooled like the enemies themselves: a released instance is scaled to
+ * zero and handed out again, so indices never shift. The horde simulation writes
+ * transforms and custom data into CPU-side arrays during its step and calls
+ * FlushInstances once at the end, which submits one batch update per dirty component.
+ */
+UCLASS()
+class FIRSTHORDESURVIVOR_API UHordeRenderSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// USubsystem interface
+	virtual void Deinitialize() override;
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+
+	// Claim an instance in the batch for Mesh + Material. Returns false (outputs INDEX_NONE) if Mesh is null.
+	bool AcquireInstance(UStaticMesh* Mesh, UMaterialInterface* Material, const FTransform& Transform,
+		const FLinearColor& Color, float EmissiveStrength, int32& OutBatch, int32& OutInstance);
+
+	// Hide the instance and return it to its batch's free list
+	void ReleaseInstance(int32 Batch, int32 Instance);
+
+	// Buffered until FlushInstances
+	void SetInstanceTransform(int32 Batch, int32 Instance, const FTransform& Transform);
+	void SetInstanceCustomData(int32 Batch, int32 Instance, int32 DataIndex, float Value);
+
+	// Submit all buffered transform and custom data changes (one update per dirty batch)
+	void FlushInstances();
+
+	// One material instance per enemy type (archetype index), created on first use and shared by
+	// every enemy of that type across pool cycles. Color/EmissiveStrength are set as parameters;
+	// a hit flash swaps the enemy onto its own cached material while it lasts (ASurvivorEnemy::SetHitFlashVisual).
+	UMaterialInterface* GetSharedEnemyMaterial(int32 ArchetypeIndex, const FEnemyArchetype& Archetype);
+
+	// Drop every shared material; called when archetypes are rebuilt (indices are reassigned)
+	void ResetSharedEnemyMaterials();
+
+protected:
+	int32 FindOrCreateBatch(UStaticMesh* Mesh, UMaterialInterface* Material);
+
+	struct FInstanceBatch
+	{
+		TArray<FTransform> Transforms;
+		TArray<float> CustomData;			// EnemyCustomData::Num floats per instance
+		TArray<int32> FreeInstances;
+		TArray<int32> DirtyCustomData;		// Instances whose custom data changed since the last flush
+		bool bTransformsDirty = false;
+	};
+
+	// Owns the instanced components; spawned on the first AcquireInstance
+	UPROPERTY()
+	AActor* HostActor;
+
+	// One component per batch, parallel to Batches
+	UPROPERTY()
+	TArray<UInstancedStaticMeshComponent*> BatchComponents;
+
+	TArray<FInstanceBatch> Batches;
+	TMap<TPair<UStaticMesh*, UMaterialInterface*>, int32> BatchLookup;
+
+	// Shared per-type materials (GetSharedEnemyMaterial), indexed by archetype; null until first use
+	UPROPERTY()
+	TArray<UMaterialInstanceDynamic*> SharedMaterials;
+};
@@ -0,0 +1,188 @@
+#include "HordeSeparationKernel.h"
+#include "Math/VectorRegister.h"
+#include "Math/RandomStream.h"
+#include "HAL/PlatformTime.h"
+
+namespace HordeSeparationKernel
+{
+	void AccumulateScalar(const FParams& Params, const float* X, const float* Y, const float* DistToPlayer, int32 Num, FResult& OutResult)
+	{
+		const float InvRadius = 1.0f / Params.SeparationRadius;
+		const bool bMeOutsideOrbit = Params.MyDistToPlayer > Params.OrbitRadius;
+
+		for (int32 Index = 0; Index < Num; ++Index)
+		{
+			float AwayX = Params.MyX - X[Index];
+			float AwayY = Params.MyY - Y[Index];
+			float Dist = FMath::Sqrt(AwayX * AwayX + AwayY * AwayY);
+
+			if (Dist < KINDA_SMALL_NUMBER)
+			{
+				// Perfectly overlapping — push in a stable arbitrary direction
+				AwayX = 1.0f;
+				AwayY = 0.0f;
+				Dist = 1.0f;
+			}
+
+			// Force scales linearly: strongest at dist=0, zero at SeparationRadius
+			const float Strength = 1.0f - FMath::Min(Dist * InvRadius, 1.0f);
+
+			bool bOtherIsInFront = false;
+			if (Params.bHasPlayer)
+			{
+				const float OtherDist = DistToPlayer[Index];
+				bOtherIsInFront = bMeOutsideOrbit && OtherDist < Params.MyDistToPlayer;
+
+				if (OtherDist > Params.OrbitRadius && Params.MyDistToPlayer < OtherDist)
+				{
+					OutResult.CrowdPushStrength += Strength;
+				}
+			}
+
+			if (!bOtherIsInFront)
+			{
+				const float Weight = Strength / Dist;
+				OutResult.SeparationX += AwayX * Weight;
+				OutResult.SeparationY += AwayY * Weight;
+			}
+		}
+	}
+
+	void Accumulate(const FParams& Params, const float* X, const float* Y, const float* DistToPlayer, int32 Num, FResult& OutResult)
+	{
+		const VectorRegister4Float Zero = VectorZeroFloat();
+		const VectorRegister4Float One = VectorOneFloat();
+		const VectorRegister4Float Epsilon = VectorSetFloat1(KINDA_SMALL_NUMBER);
+		const VectorRegister4Float MyX = VectorSetFloat1(Params.MyX);
+		const VectorRegister4Float MyY = VectorSetFloat1(Params.MyY);
+		const VectorRegister4Float MyDist = VectorSetFloat1(Params.MyDistToPlayer);
+		const VectorRegister4Float Orbit = VectorSetFloat1(Params.OrbitRadius);
+		const VectorRegister4Float InvRadius = VectorSetFloat1(1.0f / Params.SeparationRadius);
+
+		// Lane masks that don't depend on the neighbor
+		const VectorRegister4Float HasPlayerMask = Params.bHasPlayer ? VectorCompareEQ(Zero, Zero) : Zero;
+		const VectorRegister4Float MeOutsideOrbitMask = VectorBitwiseAnd(HasPlayerMask, VectorCompareGT(MyDist, Orbit));
+
+		VectorRegister4Float SumX = Zero;
+		VectorRegister4Float SumY = Zero;
+		VectorRegister4Float SumPush = Zero;
+
+		const int32 NumVectorized = Num & ~3;
+		for (int32 Index = 0; Index < NumVectorized; Index += 4)
+		{
+			const VectorRegister4Float OtherX = VectorLoad(X + Index);
+			const VectorRegister4Float OtherY = VectorLoad(Y + Index);
+			const VectorRegister4Float OtherDist = VectorLoad(DistToPlayer + Index);
+
+			VectorRegister4Float AwayX = VectorSubtract(MyX, OtherX);
+			VectorRegister4Float AwayY = VectorSubtract(MyY, OtherY);
+			VectorRegister4Float Dist = VectorSqrt(VectorMultiplyAdd(AwayX, AwayX, VectorMultiply(AwayY, AwayY)));
+
+			// Perfectly overlapping lanes push along +X
+			const VectorRegister4Float Overlapping = VectorCompareLT(Dist, Epsilon);
+			AwayX = VectorSelect(Overlapping, One, AwayX);
+			AwayY = VectorSelect(Overlapping, Zero, AwayY);
+			Dist = VectorSelect(Overlapping, One, Dist);
+
+			const VectorRegister4Float Strength = VectorSubtract(One, VectorMin(VectorMultiply(Dist, InvRadius), One));
+
+			// Crowd push from trailing neighbors (see AccumulateScalar for the scalar form)
+			const VectorRegister4Float OtherIsBehind = VectorBitwiseAnd(HasPlayerMask,
+				VectorBitwiseAnd(VectorCompareGT(OtherDist, Orbit), VectorCompareLT(MyDist, OtherDist)));
+			SumPush = VectorAdd(SumPush, VectorSelect(OtherIsBehind, Strength, Zero));
+
+			// Separation from everyone except neighbors in front (we shove those instead)
+			const VectorRegister4Float OtherIsInFront = VectorBitwiseAnd(MeOutsideOrbitMask, VectorCompareLT(OtherDist, MyDist));
+			const VectorRegister4Float Weight = VectorSelect(OtherIsInFront, Zero, VectorDivide(Strength, Dist));
+			SumX = VectorMultiplyAdd(AwayX, Weight, SumX);
+			SumY = VectorMultiplyAdd(AwayY, Weight, SumY);
+		}
+
+		alignas(16) float Lanes[4];
+
+		VectorStoreAligned(SumX, Lanes);
+		OutResult.SeparationX += Lanes[0] + Lanes[1] + Lanes[2] + Lanes[3];
+		VectorStoreAligned(SumY, Lanes);
+		OutResult.SeparationY += Lanes[0] + Lanes[1] + Lanes[2] + Lanes[3];
+		VectorStoreAligned(SumPush, Lanes);
+		OutResult.CrowdPushStrength += Lanes[0] + Lanes[1] + Lanes[2] + Lanes[3];
+
+		AccumulateScalar(Params, X + NumVectorized, Y + NumVectorized, DistToPlayer + NumVectorized, Num - NumVectorized, OutResult);
+	}
+
+	void RunBenchmark(int32 NumNeighbors, int32 Iterations)
+	{
+		NumNeighbors = FMath::Max(1, NumNeighbors);
+		Iterations = FMath::Max(1, Iterations);
+
+		// Synthetic neighborhood: neighbors scattered inside the separation radius,
+		// player far enough away that all crowd push branches are exercised
+		FRandomStream Stream(1337);
+		const FVector2f PlayerPosition(600.0f, 0.0f);
+		const float Radius = 150.0f;
+
+		TArray<float> X, Y, DistToPlayer;
+		X.SetNumUninitialized(NumNeighbors);
+		Y.SetNumUninitialized(NumNeighbors);
+		DistToPlayer.SetNumUninitialized(NumNeighbors);
+		for (int32 Index = 0; Index < NumNeighbors; ++Index)
+		{
+			const FVector2f Offset = FVector2f(Stream.FRandRange(-1.0f, 1.0f), Stream.FRandRange(-1.0f, 1.0f)) * Radius;
+			X[Index] = Offset.X;
+			Y[Index] = Offset.Y;
+			DistToPlayer[Index] = FVector2f::Distance(Offset, PlayerPosition);
+		}
+
+		auto MakeParams = [&](int32 Iteration)
+		{
+			// Nudge our own position every iteration so nothing can be hoisted out of the loop
+			FParams Params;
+			Params.MyX = float(Iteration & 15) - 8.0f;
+			Params.MyY = float((Iteration >> 4) & 15) - 8.0f;
+			Params.MyDistToPlayer = FVector2f::Distance(FVector2f(Params.MyX, Params.MyY), PlayerPosition);
+			Params.SeparationRadius = Radius;
+			Params.bHasPlayer = true;
+			return Params;
+		};
+
+		float MaxDifference = 0.0f;
+		for (int32 Iteration = 0; Iteration < 256; ++Iteration)
+		{
+			const FParams Params = MakeParams(Iteration);
+			FResult Scalar, Vector;
+			AccumulateScalar(Params, X.GetData(), Y.GetData(), DistToPlayer.GetData(), NumNeighbors, Scalar);
+			Accumulate(Params, X.GetData(), Y.GetData(), DistToPlayer.GetData(), NumNeighbors, Vector);
+			MaxDifference = FMath::Max(MaxDifference, FMath::Abs(Scalar.SeparationX - Vector.SeparationX));
+			MaxDifference = FMath::Max(MaxDifference, FMath::Abs(Scalar.SeparationY - Vector.SeparationY));
+			MaxDifference = FMath::Max(MaxDifference, FMath::Abs(Scalar.CrowdPushStrength - Vector.CrowdPushStrength));
+		}
+
+		float Sink = 0.0f;
+
+		double StartTime = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+		{
+			FResult Result;
+			AccumulateScalar(MakeParams(Iteration), X.GetData(), Y.GetData(), DistToPlayer.GetData(), NumNeighbors, Result);
+			Sink += Result.SeparationX + Result.CrowdPushStrength;
+		}
+		const double ScalarSeconds = FPlatformTime::Seconds() - StartTime;
+
+		StartTime = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+		{
+			FResult Result;
+			Accumulate(MakeParams(Iteration), X.GetData(), Y.GetData(), DistToPlayer.GetData(), NumNeighbors, Result);
+			Sink += Result.SeparationX + Result.CrowdPushStrength;
+		}
+		const double VectorSeconds = FPlatformTime::Seconds() - StartTime;
+
+		const double NumPairs = double(NumNeighbors) * double(Iterations);
+		UE_LOG(LogTemp, Log, TEXT("SeparationKernel: %d neighbors x %d iterations | scalar %.2f ns/pair | vector %.2f ns/pair | speedup %.2fx | max diff %g (sink %g)"),
+			NumNeighbors, Iterations,
+			ScalarSeconds * 1e9 / NumPairs,
+			VectorSeconds * 1e9 / NumPairs,
+			VectorSeconds > 0.0 ? ScalarSeconds / VectorSeconds : 0.0,
+			MaxDifference, Sink);
+	}
+}
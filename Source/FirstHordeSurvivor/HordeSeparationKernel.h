@@ -0,0 +1,45 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Innermost separation / crowd push math, run once per enemy over its gathered neighbors.
+ *
+ * Neighbors are passed as packed float arrays (X, Y, distance to player) so the
+ * vector path can process 4 pairs per iteration using UE's VectorRegister4Float
+ * (SSE on x64, NEON on ARM, plain FPU when vector intrinsics are disabled).
+ * The scalar path is the reference implementation and handles the tail.
+ */
+namespace HordeSeparationKernel
+{
+	struct FParams
+	{
+		// The enemy being separated
+		float MyX = 0.0f;
+		float MyY = 0.0f;
+		float MyDistToPlayer = MAX_FLT;
+
+		float SeparationRadius = 150.0f;
+		float OrbitRadius = 120.0f;
+		bool bHasPlayer = false;
+	};
+
+	struct FResult
+	{
+		// Unnormalized sum of (Away / Dist) * Strength over neighbors we separate from
+		float SeparationX = 0.0f;
+		float SeparationY = 0.0f;
+
+		// Sum of Strength over trailing neighbors shoving us toward the player
+		float CrowdPushStrength = 0.0f;
+	};
+
+	// Vectorized: 4 neighbors per iteration, scalar tail
+	void Accumulate(const FParams& Params, const float* X, const float* Y, const float* DistToPlayer, int32 Num, FResult& OutResult);
+
+	// Reference implementation, one neighbor at a time
+	void AccumulateScalar(const FParams& Params, const float* X, const float* Y, const float* DistToPlayer, int32 Num, FResult& OutResult);
+
+	// Time both paths over synthetic neighborhoods and log ns/pair plus the max result difference
+	void RunBenchmark(int32 NumNeighbors, int32 Iterations);
+}
@@ -0,0 +1,952 @@
+#include "HordeSimulationSubsystem.h"
+#include "SurvivorEnemy.h"
+#include "EnemyTuning.h"
+#include "EnemySpatialGridSubsystem.h"
+#include "HordeSeparationKernel.h"
+#include "EnemySpawnSubsystem.h"
+#include "FlowFieldSubsystem.h"
+#include "HordeRenderSubsystem.h"
+#include "ProjectileSimulationSubsystem.h"
+#include "SurvivorCharacter.h"
+#include "Components/CapsuleComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "Async/ParallelFor.h"
+#include "Camera/PlayerCameraManager.h"
+#include "GameFramework/PlayerController.h"
+#include "SceneManagement.h"
+#include "GameFramework/Character.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "Kismet/GameplayStatics.h"
+#include "Engine/World.h"
+
+void UHordeSimulationSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+	SpatialGrid = Collection.InitializeDependency<UEnemySpatialGridSubsystem>();
+	FlowField = Collection.InitializeDependency<UFlowFieldSubsystem>();
+	RenderSubsystem = Collection.InitializeDependency<UHordeRenderSubsystem>();
+	ProjectileSimulation = Collection.InitializeDependency<UProjectileSimulationSubsystem>();
+}
+
+void UHordeSimulationSubsystem::Deinitialize()
+{
+	Enemies.Empty();
+	Positions.Empty();
+	GridHandles.Empty();
+	KnockbackVelocities.Empty();
+	CrowdPushVelocities.Empty();
+	HitFlashIntensities.Empty();
+	HitFlashHoldTimers.Empty();
+	KnockbackMasses.Empty();
+	MaxWalkSpeeds.Empty();
+	HealthFractions.Empty();
+	AttackDamages.Empty();
+	AttackCooldowns.Empty();
+	LastContactSteps.Empty();
+	KinematicFlags.Empty();
+	ClampToFloorFlags.Empty();
+	Velocities.Empty();
+	MoveInputs.Empty();
+	MaxAccelerations.Empty();
+	FloorHeights.Empty();
+	MoveIntents.Empty();
+	HitFlashVisuals.Empty();
+	LODTiers.Empty();
+	RenderBatches.Empty();
+	RenderInstances.Empty();
+	PoolSlots.Empty();
+	ChainRows.Empty();
+	ChainHitBits.Empty();
+	FreeChainRows.Empty();
+	ChainRowWords = 0;
+	NumChainRows = 0;
+	SeparationInputs.Empty();
+	CrowdPushInputs.Empty();
+	PlayerDistances.Empty();
+	ContactHits.Empty();
+
+	Super::Deinitialize();
+}
+
+bool UHordeSimulationSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	// Only create for game worlds, not editor preview
+	UWorld* World = Cast<UWorld>(Outer);
+	return World && World->IsGameWorld();
+}
+
+TStatId UHordeSimulationSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UHordeSimulationSubsystem, STATGROUP_Tickables);
+}
+
+void UHordeSimulationSubsystem::RegisterEnemy(ASurvivorEnemy* Enemy)
+{
+	if (!Enemy || Enemy->HordeIndex != INDEX_NONE)
+	{
+		return;
+	}
+
+	// Level-placed enemies never went through the pool; give them a slot (and a handle) of their own
+	if (Enemy->PoolSlot == INDEX_NONE)
+	{
+		if (UEnemySpawnSubsystem* SpawnSubsystem = GetWorld()->GetSubsystem<UEnemySpawnSubsystem>())
+		{
+			SpawnSubsystem->AdoptEnemy(Enemy);
+		}
+	}
+
+	if (Enemy->PoolSlot == INDEX_NONE)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("HordeSimulation: %s has no pool slot, not simulating"), *Enemy->GetName());
+		return;
+	}
+
+	// Chain rows need a bit for every pool slot we can see
+	EnsureChainRowWords(Enemy->PoolSlot + 1);
+
+	UCharacterMovementComponent* MoveComp = Enemy->GetCharacterMovement();
+	const bool bKinematic = Enemy->bUseKinematicMover;
+
+	FVector Location = Enemy->GetActorLocation();
+	const float FloorZ = bKinematic ? ComputeFloorZ(Enemy) : Location.Z;
+	if (bKinematic && Location.Z != FloorZ)
+	{
+		// Snap onto the floor once here; from now on Z never changes
+		Location.Z = FloorZ;
+		Enemy->SetActorLocation(Location);
+	}
+
+	// Instanced enemies draw through a shared batch; their own mesh stays hidden
+	int32 RenderBatch = INDEX_NONE;
+	int32 RenderInstance = INDEX_NONE;
+	const UEnemySpawnSubsystem* SpawnSubsystem = GetWorld()->GetSubsystem<UEnemySpawnSubsystem>();
+	const FEnemyArchetype* Archetype = SpawnSubsystem ? SpawnSubsystem->GetArchetype(Enemy->ArchetypeIndex) : nullptr;
+	if (Enemy->bUseInstancedRendering && RenderSubsystem && Archetype)
+	{
+		if (!RenderSubsystem->AcquireInstance(Archetype->Mesh, Archetype->BaseMaterial,
+			Enemy->EnemyMeshComp->GetComponentTransform(), Archetype->Color, Archetype->EmissiveStrength, RenderBatch, RenderInstance))
+		{
+			Enemy->EnemyMeshComp->SetVisibility(true);
+		}
+	}
+
+	Enemy->HordeIndex = Enemies.Add(Enemy);
+	Positions.Add(Location);
+	KnockbackVelocities.Add(FVector::ZeroVector);
+	CrowdPushVelocities.Add(FVector::ZeroVector);
+	HitFlashIntensities.Add(0.0f);
+	HitFlashHoldTimers.Add(0.0f);
+	KnockbackMasses.Add(Enemy->GetKnockbackMass());
+	MaxWalkSpeeds.Add(FMath::Max(1.0f, MoveComp->MaxWalkSpeed));
+	HealthFractions.Add(1.0f);
+	AttackDamages.Add(Archetype ? Archetype->BaseDamage : 0.0f);
+	AttackCooldowns.Add(0.0f);
+	LastContactSteps.Add(0);
+	KinematicFlags.Add(bKinematic);
+	ClampToFloorFlags.Add(bKinematic && Enemy->bClampToFloorBounds);
+	Velocities.Add(FVector::ZeroVector);
+	MoveInputs.Add(FVector::ZeroVector);
+	MaxAccelerations.Add(MoveComp->GetMaxAcceleration());
+	FloorHeights.Add(FloorZ);
+	MoveIntents.Add(FVector::ZeroVector);
+	HitFlashVisuals.Add(0.0f);
+	LODTiers.Add(EHordeSimLOD::Unknown);
+	RenderBatches.Add(RenderBatch);
+	RenderInstances.Add(RenderInstance);
+	PoolSlots.Add(Enemy->PoolSlot);
+	ChainRows.Add(INDEX_NONE);
+}
+
+void UHordeSimulationSubsystem::UnregisterEnemy(ASurvivorEnemy* Enemy)
+{
+	if (!Enemy || !Enemies.IsValidIndex(Enemy->HordeIndex) || Enemies[Enemy->HordeIndex] != Enemy)
+	{
+		return;
+	}
+
+	const int32 Index = Enemy->HordeIndex;
+	Enemy->HordeIndex = INDEX_NONE;
+
+	// Hide the instance right away, even if the slot itself is compacted later
+	if (RenderBatches[Index] != INDEX_NONE && RenderSubsystem)
+	{
+		RenderSubsystem->ReleaseInstance(RenderBatches[Index], RenderInstances[Index]);
+		RenderBatches[Index] = INDEX_NONE;
+	}
+
+	// Enemies can die mid-step (a write-back SetActorLocation overlapping a projectile).
+	// Leave a hole so indices stay stable for the rest of the loop; compact afterwards.
+	if (bIsStepping)
+	{
+		Enemies[Index] = nullptr;
+		PendingRemovals.Add(Index);
+		return;
+	}
+
+	RemoveAtSwap(Index);
+}
+
+void UHordeSimulationSubsystem::RemoveAtSwap(int32 Index)
+{
+	// Swap-remove keeps the arrays dense; patch the index of the enemy moved into the hole
+	Enemies.RemoveAtSwap(Index, EAllowShrinking::No);
+	Positions.RemoveAtSwap(Index, EAllowShrinking::No);
+	KnockbackVelocities.RemoveAtSwap(Index, EAllowShrinking::No);
+	CrowdPushVelocities.RemoveAtSwap(Index, EAllowShrinking::No);
+	HitFlashIntensities.RemoveAtSwap(Index, EAllowShrinking::No);
+	HitFlashHoldTimers.RemoveAtSwap(Index, EAllowShrinking::No);
+	KnockbackMasses.RemoveAtSwap(Index, EAllowShrinking::No);
+	MaxWalkSpeeds.RemoveAtSwap(Index, EAllowShrinking::No);
+	HealthFractions.RemoveAtSwap(Index, EAllowShrinking::No);
+	AttackDamages.RemoveAtSwap(Index, EAllowShrinking::No);
+	AttackCooldowns.RemoveAtSwap(Index, EAllowShrinking::No);
+	LastContactSteps.RemoveAtSwap(Index, EAllowShrinking::No);
+	KinematicFlags.RemoveAtSwap(Index, EAllowShrinking::No);
+	ClampToFloorFlags.RemoveAtSwap(Index, EAllowShrinking::No);
+	Velocities.RemoveAtSwap(Index, EAllowShrinking::No);
+	MoveInputs.RemoveAtSwap(Index, EAllowShrinking::No);
+	MaxAccelerations.RemoveAtSwap(Index, EAllowShrinking::No);
+	FloorHeights.RemoveAtSwap(Index, EAllowShrinking::No);
+	MoveIntents.RemoveAtSwap(Index, EAllowShrinking::No);
+	HitFlashVisuals.RemoveAtSwap(Index, EAllowShrinking::No);
+	LODTiers.RemoveAtSwap(Index, EAllowShrinking::No);
+	RenderBatches.RemoveAtSwap(Index, EAllowShrinking::No);
+	RenderInstances.RemoveAtSwap(Index, EAllowShrinking::No);
+	ReleaseChainRow(Index);
+	PoolSlots.RemoveAtSwap(Index, EAllowShrinking::No);
+	ChainRows.RemoveAtSwap(Index, EAllowShrinking::No);
+
+	if (Enemies.IsValidIndex(Index))
+	{
+		Enemies[Index]->HordeIndex = Index;
+	}
+}
+
+void UHordeSimulationSubsystem::FlushPendingRemovals()
+{
+	// Highest index first: anything swapped into a hole comes from the tail, which has
+	// already been compacted, so it is never itself a pending hole.
+	PendingRemovals.Sort(TGreater<int32>());
+	for (int32 Index : PendingRemovals)
+	{
+		RemoveAtSwap(Index);
+	}
+	PendingRemovals.Reset();
+}
+
+void UHordeSimulationSubsystem::ApplyKnockback(int32 Index, const FVector& Impulse)
+{
+	if (!Enemies.IsValidIndex(Index))
+	{
+		return;
+	}
+
+	// Add to existing knockback velocity (allows stacking)
+	KnockbackVelocities[Index] += Impulse;
+
+	// Clear hit tracking for new knockback chain
+	if (ChainRows[Index] == INDEX_NONE)
+	{
+		ChainRows[Index] = AcquireChainRow();
+	}
+	FMemory::Memzero(GetChainRow(ChainRows[Index]), ChainRowWords * sizeof(uint64));
+}
+
+int32 UHordeSimulationSubsystem::AcquireChainRow()
+{
+	if (FreeChainRows.Num() > 0)
+	{
+		return FreeChainRows.Pop(EAllowShrinking::No);
+	}
+
+	ChainHitBits.AddZeroed(ChainRowWords);
+	return NumChainRows++;
+}
+
+void UHordeSimulationSubsystem::ReleaseChainRow(int32 Index)
+{
+	if (ChainRows[Index] != INDEX_NONE)
+	{
+		FreeChainRows.Add(ChainRows[Index]);
+		ChainRows[Index] = INDEX_NONE;
+	}
+}
+
+void UHordeSimulationSubsystem::EnsureChainRowWords(int32 NumPoolSlots)
+{
+	const int32 RequiredWords = FMath::DivideAndRoundUp(FMath::Max(NumPoolSlots, 1), 64);
+	if (RequiredWords <= ChainRowWords)
+	{
+		return;
+	}
+
+	// The pool grew past the row width: re-lay every row out at the new stride.
+	// Only happens when new enemy actors are created, never in steady state.
+	const int32 NewRowWords = FMath::Max(RequiredWords, ChainRowWords * 2);
+	TArray<uint64> NewBits;
+	NewBits.SetNumZeroed(NumChainRows * NewRowWords);
+	for (int32 Row = 0; Row < NumChainRows; ++Row)
+	{
+		FMemory::Memcpy(NewBits.GetData() + Row * NewRowWords, GetChainRow(Row), ChainRowWords * sizeof(uint64));
+	}
+
+	ChainHitBits = MoveTemp(NewBits);
+	ChainRowWords = NewRowWords;
+}
+
+void UHordeSimulationSubsystem::TriggerHitFlash(int32 Index)
+{
+	if (!Enemies.IsValidIndex(Index))
+	{
+		return;
+	}
+
+	HitFlashIntensities[Index] = 1.0f;
+	HitFlashHoldTimers[Index] = HitFlashSettings::HoldDuration;
+
+	// Offscreen enemies pick the flash up (or its end) when they come back into view
+	if (LODTiers[Index] != EHordeSimLOD::NearOffscreen && LODTiers[Index] != EHordeSimLOD::FarOffscreen)
+	{
+		HitFlashVisuals[Index] = 1.0f;
+		PushHitFlashVisual(Index, 1.0f);
+	}
+}
+
+void UHordeSimulationSubsystem::SetHealthFraction(int32 Index, float Fraction)
+{
+	if (Enemies.IsValidIndex(Index))
+	{
+		HealthFractions[Index] = FMath::Clamp(Fraction, 0.0f, 1.0f);
+	}
+}
+
+void UHordeSimulationSubsystem::GetVisibleHealthBars(float HeightOffset, TArray<FHordeHealthBar>& OutBars) const
+{
+	for (int32 Index = 0; Index < Enemies.Num(); ++Index)
+	{
+		// Full-health enemies show no bar; offscreen ones were culled by the LOD pass
+		if (Enemies[Index] && HealthFractions[Index] < 1.0f && LODTiers[Index] == EHordeSimLOD::OnScreen)
+		{
+			OutBars.Add({ Positions[Index] + FVector(0.0f, 0.0f, HeightOffset), HealthFractions[Index] });
+		}
+	}
+}
+
+void UHordeSimulationSubsystem::Tick(float DeltaTime)
+{
+	StepHorde(DeltaTime);
+
+	// Projectiles sweep against the grid this step just built and write their instances into the same batches
+	if (ProjectileSimulation)
+	{
+		ProjectileSimulation->StepProjectiles(DeltaTime);
+	}
+
+	// One submission per instance batch (enemies and projectiles), including instances released this frame
+	if (RenderSubsystem)
+	{
+		RenderSubsystem->FlushInstances();
+	}
+}
+
+void UHordeSimulationSubsystem::StepHorde(float DeltaTime)
+{
+	const int32 Count = Enemies.Num();
+	UWorld* World = GetWorld();
+
+	// Pull in where CharacterMovement left everyone, then index them for neighbor queries
+	for (int32 Index = 0; Index < Count; ++Index)
+	{
+		Positions[Index] = Enemies[Index]->GetActorLocation();
+	}
+
+	if (SpatialGrid)
+	{
+		const UEnemySpawnSubsystem* SpawnSubsystem = World->GetSubsystem<UEnemySpawnSubsystem>();
+		GridHandles.SetNumUninitialized(Count, EAllowShrinking::No);
+		for (int32 Index = 0; Index < Count; ++Index)
+		{
+			GridHandles[Index] = SpawnSubsystem ? SpawnSubsystem->GetEnemyHandle(Enemies[Index]) : FEnemyHandle();
+		}
+		SpatialGrid->Rebuild(Enemies, Positions, GridHandles);
+	}
+
+	if (Count == 0)
+	{
+		return;
+	}
+
+	ACharacter* Player = UGameplayStatics::GetPlayerCharacter(World, 0);
+	const bool bHasPlayer = Player != nullptr;
+	const FVector PlayerLocation = bHasPlayer ? Player->GetActorLocation() : FVector::ZeroVector;
+
+	// Only does real work when the player crosses into a new cell
+	if (FlowField && bHasPlayer)
+	{
+		FlowField->UpdateGoal(PlayerLocation);
+	}
+
+	// Kinematic enemies with bClampToFloorBounds are kept inside the LevelFloor instead of being blocked by walls
+	bHasMoverBounds = false;
+	if (UEnemySpawnSubsystem* SpawnSubsystem = World->GetSubsystem<UEnemySpawnSubsystem>())
+	{
+		bHasMoverBounds = SpawnSubsystem->GetFloorBounds(MoverBounds);
+		MoverBounds = MoverBounds.ExpandBy(-KinematicMoverSettings::WallMargin);
+	}
+
+	bIsStepping = true;
+
+	// Phase 1 (game thread): knockback and crowd push move enemies (neighbors from the spatial grid, no physics queries)
+	for (int32 Index = 0; Index < Count; ++Index)
+	{
+		if (!Enemies[Index])
+		{
+			continue;
+		}
+
+		bool bMoved = ProcessKnockback(Index, DeltaTime);
+		bMoved |= ProcessCrowdPush(Index, DeltaTime);
+
+		// CharacterMovement enemies only see the displacement through their actor transform, so it
+		// is still written here. Neighbor queries read Positions, not the actors.
+		// Kinematic enemies write their transform once, at the end of their step.
+		if (bMoved && !KinematicFlags[Index])
+		{
+			Enemies[Index]->SetActorLocation(Positions[Index]);
+		}
+	}
+
+	// Phase 2 (worker threads): read-only separation gather into per-enemy accumulators
+	SeparationInputs.SetNumUninitialized(Count, EAllowShrinking::No);
+	CrowdPushInputs.SetNumUninitialized(Count, EAllowShrinking::No);
+
+	// Distance to the player is needed for every pair; compute it once per enemy
+	const FVector2f PlayerPosition = UEnemySpatialGridSubsystem::ToGridPosition(PlayerLocation);
+	PlayerDistances.SetNumUninitialized(Count, EAllowShrinking::No);
+	for (int32 Index = 0; Index < Count; ++Index)
+	{
+		PlayerDistances[Index] = bHasPlayer
+			? FVector2f::Distance(UEnemySpatialGridSubsystem::ToGridPosition(Positions[Index]), PlayerPosition)
+			: MAX_FLT;
+	}
+
+	// Decide who gets a full update this step (needs PlayerDistances)
+	UpdateLODTiers();
+	++StepCounter;
+
+	const EParallelForFlags GatherFlags = Count >= HordeParallelSettings::MinParallelCount
+		? EParallelForFlags::None
+		: EParallelForFlags::ForceSingleThread;
+
+	ParallelFor(TEXT("HordeSeparationGather"), Count, HordeParallelSettings::GatherBatchSize, [&](int32 Index)
+	{
+		if (ShouldFullUpdate(Index))
+		{
+			GatherSeparation(Index, PlayerPosition, bHasPlayer);
+		}
+	}, GatherFlags);
+
+	// Phase 3 (game thread): apply accumulated input and pushes, then per-enemy follow-up
+	for (int32 Index = 0; Index < Count; ++Index)
+	{
+		if (!Enemies[Index])
+		{
+			continue;
+		}
+
+		const bool bOnScreen = LODTiers[Index] == EHordeSimLOD::OnScreen;
+
+		// Reduced-rate enemies re-apply their last intent in between updates, so they
+		// keep moving (extrapolated) without paying for separation or steering
+		if (ShouldFullUpdate(Index))
+		{
+			MoveIntents[Index] = FVector::ZeroVector;
+			CommitSeparation(Index);
+
+			if (bHasPlayer)
+			{
+				ProcessChase(Index, PlayerLocation, bOnScreen);
+			}
+		}
+		AddMoveInput(Index, MoveIntents[Index]);
+
+		if (KinematicFlags[Index])
+		{
+			ProcessKinematicMove(Index, DeltaTime, PlayerLocation, bHasPlayer && bOnScreen);
+			if (!Enemies[Index])
+			{
+				continue;
+			}
+		}
+
+		ProcessHitFlash(Index, DeltaTime, bOnScreen);
+	}
+
+	if (bHasPlayer)
+	{
+		ResolveContactDamage(DeltaTime, Player);
+	}
+
+	SyncRenderInstances();
+
+	bIsStepping = false;
+	FlushPendingRemovals();
+}
+
+bool UHordeSimulationSubsystem::ProcessKnockback(int32 Index, float DeltaTime)
+{
+	FVector& Velocity = KnockbackVelocities[Index];
+
+	// Skip if not being knocked back
+	if (Velocity.IsNearlyZero(KnockbackSettings::MinVelocityThreshold))
+	{
+		Velocity = FVector::ZeroVector;
+		ReleaseChainRow(Index);
+		return false;
+	}
+
+	// Move by knockback velocity
+	Positions[Index] += Velocity * DeltaTime;
+
+	// Check for collisions with other enemies. Neighbors come from the grid; the contact
+	// test uses live positions so enemies already shoved this step are hit where they are now.
+	const int32 ChainRow = ChainRows[Index];
+	const FVector2f MyPosition = UEnemySpatialGridSubsystem::ToGridPosition(Positions[Index]);
+	const float ContactRadius = KnockbackSettings::CollisionCheckRadius + KnockbackSettings::EnemyBodyRadius;
+
+	if (SpatialGrid && ChainRow != INDEX_NONE)
+	{
+		SpatialGrid->ForEachInRadius(MyPosition, ContactRadius,
+			[&](int32 OtherIndex, const FVector2f& GridPosition, float GridDistSq)
+		{
+			if (OtherIndex == Index || !Enemies[OtherIndex])
+			{
+				return;
+			}
+
+			const FVector2f OtherPosition = UEnemySpatialGridSubsystem::ToGridPosition(Positions[OtherIndex]);
+			if (FVector2f::DistSquared(MyPosition, OtherPosition) > FMath::Square(ContactRadius))
+			{
+				return;
+			}
+
+			// Mark as hit to prevent double-transfer
+			const int32 OtherSlot = PoolSlots[OtherIndex];
+			uint64& HitWord = GetChainRow(ChainRow)[OtherSlot >> 6];
+			const uint64 HitBit = uint64(1) << (OtherSlot & 63);
+			if (HitWord & HitBit)
+			{
+				return;
+			}
+			HitWord |= HitBit;
+
+			// Calculate momentum transfer based on mass
+			float MyMass = KnockbackMasses[Index];
+			float OtherMass = KnockbackMasses[OtherIndex];
+			float MassRatio = MyMass / (MyMass + OtherMass);
+
+			// Direction from me to them
+			FVector PushDir = FVector(OtherPosition.X - MyPosition.X, OtherPosition.Y - MyPosition.Y, 0.0f).GetSafeNormal();
+			if (PushDir.IsNearlyZero())
+			{
+				PushDir = Velocity.GetSafeNormal2D();
+			}
+
+			// Transfer momentum: heavier enemies get pushed less
+			float TransferSpeed = Velocity.Size() * KnockbackSettings::MomentumTransferRatio * MassRatio;
+
+			// Apply to the other enemy (this can chain!)
+			ApplyKnockback(OtherIndex, PushDir * TransferSpeed);
+
+			// Reduce our own velocity
+			Velocity *= KnockbackSettings::PusherMomentumRetention;
+		});
+	}
+
+	// Apply friction deceleration
+	float Speed = Velocity.Size();
+	float NewSpeed = FMath::Max(0.0f, Speed - KnockbackSettings::FrictionDeceleration * DeltaTime);
+
+	if (NewSpeed < KnockbackSettings::MinVelocityThreshold)
+	{
+		Velocity = FVector::ZeroVector;
+		ReleaseChainRow(Index);
+	}
+	else
+	{
+		Velocity = Velocity.GetSafeNormal() * NewSpeed;
+	}
+
+	return true;
+}
+
+bool UHordeSimulationSubsystem::ProcessCrowdPush(int32 Index, float DeltaTime)
+{
+	FVector& PushVelocity = CrowdPushVelocities[Index];
+	if (PushVelocity.IsNearlyZero(1.0f))
+	{
+		return false;
+	}
+
+	Positions[Index] += PushVelocity * DeltaTime;
+	float PushSpeed = PushVelocity.Size();
+	float NewPushSpeed = FMath::Max(0.f, PushSpeed - CrowdPushSettings::PushDecay * DeltaTime);
+	PushVelocity = NewPushSpeed > 1.f ? PushVelocity.GetSafeNormal() * NewPushSpeed : FVector::ZeroVector;
+	return true;
+}
+
+void UHordeSimulationSubsystem::GatherSeparation(int32 Index, const FVector2f& PlayerPosition, bool bHasPlayer)
+{
+	// Runs on worker threads. Only reads shared state; only writes this enemy's accumulators.
+	//
+	// Crowd push is gathered from the receiver's side: instead of "I shove the neighbor in
+	// front of me", each enemy sums the shoves it receives from the neighbors behind it.
+	// Same pairs, same forces, but no thread ever writes another enemy's slot.
+	if (!Enemies[Index] || !SpatialGrid)
+	{
+		SeparationInputs[Index] = FVector::ZeroVector;
+		CrowdPushInputs[Index] = FVector::ZeroVector;
+		return;
+	}
+
+	// Neighbors are found through the grid (bucketed at the start of this step) but their
+	// positions are read from the live arrays, so pushes see this frame's knockback movement.
+	// They're packed into contiguous buffers so the kernel can process 4 pairs at a time.
+	const FVector2f MyPosition = UEnemySpatialGridSubsystem::ToGridPosition(Positions[Index]);
+
+	TArray<float, TInlineAllocator<128>> NeighborX;
+	TArray<float, TInlineAllocator<128>> NeighborY;
+	TArray<float, TInlineAllocator<128>> NeighborDistToPlayer;
+
+	SpatialGrid->ForEachInRadius(MyPosition, SeparationSettings::SeparationRadius,
+		[&](int32 OtherIndex, const FVector2f& GridPosition, float GridDistSq)
+	{
+		if (OtherIndex == Index || !Enemies[OtherIndex])
+		{
+			return;
+		}
+
+		NeighborX.Add((float)Positions[OtherIndex].X);
+		NeighborY.Add((float)Positions[OtherIndex].Y);
+		NeighborDistToPlayer.Add(PlayerDistances[OtherIndex]);
+	});
+
+	// Crowd push only counts pushers still approaching (outside orbit radius).
+	// Once at the player, everyone spreads via normal separation instead of
+	// shoving front-row enemies through the player into a blob.
+	HordeSeparationKernel::FParams Params;
+	Params.MyX = MyPosition.X;
+	Params.MyY = MyPosition.Y;
+	Params.MyDistToPlayer = PlayerDistances[Index];
+	Params.SeparationRadius = SeparationSettings::SeparationRadius;
+	Params.OrbitRadius = OrbitSettings::OrbitRadius;
+	Params.bHasPlayer = bHasPlayer;
+
+	HordeSeparationKernel::FResult Result;
+	HordeSeparationKernel::Accumulate(Params, NeighborX.GetData(), NeighborY.GetData(), NeighborDistToPlayer.GetData(), NeighborX.Num(), Result);
+
+	SeparationInputs[Index] = FVector(Result.SeparationX, Result.SeparationY, 0.0f);
+
+	// Everyone pushing me shoves me straight at the player
+	const FVector2f ToPlayer = (PlayerPosition - MyPosition).GetSafeNormal();
+	CrowdPushInputs[Index] = FVector(ToPlayer.X, ToPlayer.Y, 0.0f) * Result.CrowdPushStrength * CrowdPushSettings::MaxPushSpeed;
+}
+
+void UHordeSimulationSubsystem::CommitSeparation(int32 Index)
+{
+	if (!CrowdPushInputs[Index].IsNearlyZero())
+	{
+		// Reduced-rate enemies gather pushes less often; scale up so the crowd feels the same
+		const FVector Push = CrowdPushInputs[Index] * GetUpdateInterval(LODTiers[Index]);
+		CrowdPushVelocities[Index] = (CrowdPushVelocities[Index] + Push).GetClampedToMaxSize(CrowdPushSettings::MaxPushSpeed);
+	}
+
+	FVector SeparationInput = SeparationInputs[Index];
+	if (!SeparationInput.IsNearlyZero())
+	{
+		// Normalise direction, scale to a fixed max speed, then feed as input
+		// (AddInputVector is consumed by CharacterMovement and blended with walk speed)
+		SeparationInput = SeparationInput.GetSafeNormal()
+			* (SeparationSettings::MaxSeparationSpeed / MaxWalkSpeeds[Index]);
+		MoveIntents[Index] += SeparationInput;
+	}
+}
+
+void UHordeSimulationSubsystem::ProcessChase(int32 Index, const FVector& PlayerLocation, bool bFacePlayer)
+{
+	// Direct vector movement for "dumb" chasing — cheap and effective for hordes
+	FVector ToPlayer = PlayerLocation - Positions[Index];
+	ToPlayer.Z = 0.0f;
+	float DistToPlayer = ToPlayer.Size2D();
+
+	if (DistToPlayer > OrbitSettings::OrbitRadius)
+	{
+		// Outside orbit radius: chase toward player normally.
+		// Further out, follow the shared flow field so walls are routed around.
+		FVector ChaseDir = ToPlayer / DistToPlayer;
+		if (FlowField && DistToPlayer > FlowFieldSettings::DirectChaseRadius)
+		{
+			const FVector2f FlowDir = FlowField->GetDirection(Positions[Index]);
+			if (!FlowDir.IsZero())
+			{
+				ChaseDir = FVector(FlowDir.X, FlowDir.Y, 0.0f);
+			}
+		}
+		MoveIntents[Index] += ChaseDir;
+	}
+	// Inside orbit radius: don't push further in.
+	// The separation force handles lateral positioning naturally.
+
+	// Always face the player regardless of movement (kinematic enemies do this in their move).
+	// Offscreen enemies skip it; nobody can see which way they face.
+	if (bFacePlayer && DistToPlayer > KINDA_SMALL_NUMBER && !KinematicFlags[Index])
+	{
+		Enemies[Index]->SetActorRotation((ToPlayer / DistToPlayer).Rotation());
+	}
+}
+
+void UHordeSimulationSubsystem::AddMoveInput(int32 Index, const FVector& Input)
+{
+	if (KinematicFlags[Index])
+	{
+		MoveInputs[Index] += Input;
+	}
+	else
+	{
+		Enemies[Index]->GetCharacterMovement()->AddInputVector(Input);
+	}
+}
+
+void UHordeSimulationSubsystem::ProcessKinematicMove(int32 Index, float DeltaTime, const FVector& PlayerLocation, bool bFacePlayer)
+{
+	// Same contract as CharacterMovement walking: input is clamped to unit length and
+	// scales the target speed; velocity approaches it at MaxAcceleration.
+	FVector Input = MoveInputs[Index].GetClampedToMaxSize(1.0f);
+	Input.Z = 0.0f;
+	MoveInputs[Index] = FVector::ZeroVector;
+
+	FVector& Velocity = Velocities[Index];
+	Velocity = FMath::VInterpConstantTo(Velocity, Input * MaxWalkSpeeds[Index], DeltaTime, MaxAccelerations[Index]);
+
+	FVector& Position = Positions[Index];
+	Position += Velocity * DeltaTime;
+	Position.Z = FloorHeights[Index];
+
+	if (bHasMoverBounds && ClampToFloorFlags[Index])
+	{
+		// Stand-in for wall collision: stop at the floor edge and drop the velocity into it
+		const FVector Clamped(
+			FMath::Clamp(Position.X, MoverBounds.Min.X, MoverBounds.Max.X),
+			FMath::Clamp(Position.Y, MoverBounds.Min.Y, MoverBounds.Max.Y),
+			Position.Z);
+		if (Clamped.X != Position.X)
+		{
+			Velocity.X = 0.0f;
+		}
+		if (Clamped.Y != Position.Y)
+		{
+			Velocity.Y = 0.0f;
+		}
+		Position = Clamped;
+	}
+
+	// Single transform write per enemy per frame: no sweep, no floor check
+	ASurvivorEnemy* Enemy = Enemies[Index];
+	const FVector ToPlayer(PlayerLocation.X - Position.X, PlayerLocation.Y - Position.Y, 0.0f);
+	if (bFacePlayer && !ToPlayer.IsNearlyZero())
+	{
+		Enemy->SetActorLocationAndRotation(Position, ToPlayer.Rotation());
+	}
+	else
+	{
+		Enemy->SetActorLocation(Position);
+	}
+}
+
+float UHordeSimulationSubsystem::ComputeFloorZ(const ASurvivorEnemy* Enemy) const
+{
+	FBox FloorBounds;
+	UEnemySpawnSubsystem* SpawnSubsystem = GetWorld()->GetSubsystem<UEnemySpawnSubsystem>();
+	if (!SpawnSubsystem || !SpawnSubsystem->GetFloorBounds(FloorBounds))
+	{
+		// No LevelFloor: trust the spawn height
+		return Enemy->GetActorLocation().Z;
+	}
+
+	return FloorBounds.Max.Z + Enemy->GetCapsuleComponent()->GetScaledCapsuleHalfHeight();
+}
+
+void UHordeSimulationSubsystem::ProcessHitFlash(int32 Index, float DeltaTime, bool bOnScreen)
+{
+	float& Intensity = HitFlashIntensities[Index];
+	if (Intensity > 0.0f)
+	{
+		float& HoldTimer = HitFlashHoldTimers[Index];
+		if (HoldTimer > 0.0f)
+		{
+			// Still holding at full intensity
+			HoldTimer -= DeltaTime;
+		}
+		else
+		{
+			// Decay after hold period
+			Intensity = FMath::Max(0.0f, Intensity - DeltaTime * HitFlashSettings::DecayRate);
+		}
+	}
+
+	// Material updates only for enemies on screen, and only when the value changed
+	if (bOnScreen && HitFlashVisuals[Index] != Intensity)
+	{
+		HitFlashVisuals[Index] = Intensity;
+		PushHitFlashVisual(Index, Intensity);
+	}
+}
+
+void UHordeSimulationSubsystem::PushHitFlashVisual(int32 Index, float Intensity)
+{
+	if (RenderBatches[Index] != INDEX_NONE)
+	{
+		RenderSubsystem->SetInstanceCustomData(RenderBatches[Index], RenderInstances[Index], EnemyCustomData::HitFlashIntensity, Intensity);
+	}
+	else
+	{
+		Enemies[Index]->SetHitFlashVisual(Intensity);
+	}
+}
+
+void UHordeSimulationSubsystem::SyncRenderInstances()
+{
+	if (!RenderSubsystem)
+	{
+		return;
+	}
+
+	// Movement for this frame is final here (CharacterMovement ran in the actor tick groups,
+	// kinematic enemies were just moved), so the hidden mesh component holds the draw transform
+	for (int32 Index = 0; Index < Enemies.Num(); ++Index)
+	{
+		if (Enemies[Index] && RenderBatches[Index] != INDEX_NONE)
+		{
+			RenderSubsystem->SetInstanceTransform(RenderBatches[Index], RenderInstances[Index],
+				Enemies[Index]->EnemyMeshComp->GetComponentTransform());
+		}
+	}
+}
+
+int32 UHordeSimulationSubsystem::GetUpdateInterval(EHordeSimLOD Tier) const
+{
+	switch (Tier)
+	{
+	case EHordeSimLOD::NearOffscreen:
+		return NearOffscreenInterval;
+	case EHordeSimLOD::FarOffscreen:
+		return FarOffscreenInterval;
+	default:
+		return 1;
+	}
+}
+
+bool UHordeSimulationSubsystem::ShouldFullUpdate(int32 Index) const
+{
+	// Stagger by pool slot so reduced-rate enemies spread evenly over frames
+	const int32 Interval = GetUpdateInterval(LODTiers[Index]);
+	return Interval <= 1 || (StepCounter + uint32(PoolSlots[Index])) % uint32(Interval) == 0;
+}
+
+void UHordeSimulationSubsystem::UpdateLODTiers()
+{
+	UWorld* World = GetWorld();
+	const int32 Count = Enemies.Num();
+
+	// Thresholds live on the spawner alongside the other horde tuning
+	UEnemySpawnSubsystem* SpawnSubsystem = World->GetSubsystem<UEnemySpawnSubsystem>();
+	const bool bEnabled = SpawnSubsystem && SpawnSubsystem->bEnableSimulationLOD;
+
+	// Camera frustum of the local player; without one everybody counts as on screen
+	FConvexVolume Frustum;
+	bool bHasFrustum = false;
+	if (bEnabled)
+	{
+		APlayerController* PlayerController = World->GetFirstPlayerController();
+		if (PlayerController && PlayerController->PlayerCameraManager)
+		{
+			FMatrix ViewMatrix, ProjectionMatrix, ViewProjectionMatrix;
+			UGameplayStatics::GetViewProjectionMatrix(PlayerController->PlayerCameraManager->GetCameraCacheView(),
+				ViewMatrix, ProjectionMatrix, ViewProjectionMatrix);
+			GetViewFrustumBounds(Frustum, ViewProjectionMatrix, false);
+			bHasFrustum = true;
+		}
+	}
+
+	NearOffscreenInterval = bEnabled ? FMath::Max(1, SpawnSubsystem->LODNearOffscreenInterval) : 1;
+	FarOffscreenInterval = bEnabled ? FMath::Max(1, SpawnSubsystem->LODFarOffscreenInterval) : 1;
+	const float FrustumMargin = bEnabled ? SpawnSubsystem->LODFrustumMargin : 0.0f;
+	const float FarDistance = bEnabled ? SpawnSubsystem->LODFarDistance : MAX_FLT;
+
+	for (int32 Index = 0; Index < Count; ++Index)
+	{
+		if (!Enemies[Index])
+		{
+			continue;
+		}
+
+		EHordeSimLOD Tier = EHordeSimLOD::OnScreen;
+		if (bHasFrustum && !Frustum.IntersectSphere(Positions[Index], FrustumMargin))
+		{
+			Tier = PlayerDistances[Index] > FarDistance ? EHordeSimLOD::FarOffscreen : EHordeSimLOD::NearOffscreen;
+		}
+
+		LODTiers[Index] = Tier;
+	}
+}
+
+void UHordeSimulationSubsystem::ResolveContactDamage(float DeltaTime, ACharacter* Player)
+{
+	ASurvivorCharacter* SurvivorPlayer = Cast<ASurvivorCharacter>(Player);
+	UAttributeComponent* PlayerAttributes = SurvivorPlayer ? SurvivorPlayer->AttributeComp : nullptr;
+	if (!PlayerAttributes || !SpatialGrid)
+	{
+		return;
+	}
+
+	// Reach is measured to the player's capsule surface, like the old sphere-vs-capsule overlap
+	const UCapsuleComponent* Capsule = Player->GetCapsuleComponent();
+	const float Range = ContactDamageSettings::AttackRadius + Capsule->GetScaledCapsuleRadius();
+	const float MaxHeightDelta = ContactDamageSettings::AttackRadius + Capsule->GetScaledCapsuleHalfHeight();
+	const FVector PlayerLocation = Player->GetActorLocation();
+
+	ContactHits.Reset();
+
+	// Grid positions are from the start of the step; good enough for a 150+ uu reach
+	SpatialGrid->ForEachInRadius(UEnemySpatialGridSubsystem::ToGridPosition(PlayerLocation), Range,
+		[&](int32 Index, const FVector2f& /*Position*/, float /*DistSq*/)
+		{
+			if (!Enemies[Index] || FMath::Abs(Positions[Index].Z - PlayerLocation.Z) > MaxHeightDelta)
+			{
+				return;
+			}
+
+			// Out of range last step: this is a fresh contact, attack right away
+			if (LastContactSteps[Index] + 1 != StepCounter)
+			{
+				AttackCooldowns[Index] = 0.0f;
+			}
+			LastContactSteps[Index] = StepCounter;
+
+			AttackCooldowns[Index] -= DeltaTime;
+			if (AttackCooldowns[Index] <= 0.0f)
+			{
+				AttackCooldowns[Index] += ContactDamageSettings::AttackInterval;
+				if (AttackDamages[Index] > 0.0f)
+				{
+					ContactHits.Add({ AttackDamages[Index], Enemies[Index] });
+				}
+			}
+		});
+
+	if (ContactHits.Num() > 0)
+	{
+		PlayerAttributes->ApplyArmoredDamageBatch(ContactHits);
+	}
+}
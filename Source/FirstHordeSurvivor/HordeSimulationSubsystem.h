@@ -0,0 +1,227 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "AttributeComponent.h"
+#include "EnemyHandle.h"
+#include "HordeSimulationSubsystem.generated.h"
+
+class ASurvivorEnemy;
+class UEnemySpatialGridSubsystem;
+class UFlowFieldSubsystem;
+class UHordeRenderSubsystem;
+class UProjectileSimulationSubsystem;
+class ACharacter;
+
+// Simulation LOD tier per enemy, decided each step from the camera frustum and player distance
+enum class EHordeSimLOD : uint8
+{
+	OnScreen,		// Full rate: separation, steering, rotation, hit flash, health bar
+	NearOffscreen,	// Separation and steering every LODNearOffscreenInterval steps
+	FarOffscreen,	// Separation and steering every LODFarOffscreenInterval steps
+	Unknown = 0xFF	// Just registered, not classified yet
+};
+
+// One enemy health bar for the HUD overlay
+struct FHordeHealthBar
+{
+	FVector WorldPosition;
+	float HealthFraction;
+};
+
+/**
+ * Advances every active enemy in one tight loop per frame.
+ *
+ * Enemy motion state lives here in structure-of-arrays form, indexed by each
+ * enemy's HordeIndex. ASurvivorEnemy no longer ticks; it is a presentation and
+ * collision proxy that registers on spawn, unregisters on pool return, and
+ * forwards gameplay events (knockback, damage) into the simulation.
+ *
+ * Runs as a tickable (after all actor tick groups), so movement input added
+ * here is consumed by CharacterMovement at the start of the next frame.
+ * Enemies with bUseKinematicMover skip CharacterMovement entirely and are
+ * integrated here instead (planar, constant floor Z, no sweeps).
+ */
+UCLASS()
+class FIRSTHORDESURVIVOR_API UHordeSimulationSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// USubsystem interface
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+
+	// FTickableGameObject interface
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	// Registration (called from ASurvivorEnemy::Reinitialize / Deactivate)
+	void RegisterEnemy(ASurvivorEnemy* Enemy);
+	void UnregisterEnemy(ASurvivorEnemy* Enemy);
+
+	// Add a knockback impulse and start a new momentum-transfer chain
+	void ApplyKnockback(int32 Index, const FVector& Impulse);
+
+	// Start a hit flash (full intensity, short hold, then decay)
+	void TriggerHitFlash(int32 Index);
+
+	// Current / max health, pushed by the enemy when its health changes
+	void SetHealthFraction(int32 Index, float Fraction);
+
+	// Damaged enemies in the OnScreen LOD tier, for ASurvivorHUD (bar anchored HeightOffset above the enemy)
+	void GetVisibleHealthBars(float HeightOffset, TArray<FHordeHealthBar>& OutBars) const;
+
+	int32 GetNumEnemies() const { return Enemies.Num(); }
+
+protected:
+	void StepHorde(float DeltaTime);
+
+	// Move by knockback velocity and transfer momentum to enemies we run into (found via the grid)
+	bool ProcessKnockback(int32 Index, float DeltaTime);
+
+	// Knockback chain hit rows: one bit per pool slot, one row per enemy with an active chain
+	int32 AcquireChainRow();
+	void ReleaseChainRow(int32 Index);
+	void EnsureChainRowWords(int32 NumPoolSlots);
+	uint64* GetChainRow(int32 Row) { return ChainHitBits.GetData() + Row * ChainRowWords; }
+
+	// Apply decaying crowd push velocity (from trailing enemies shoving us toward the player)
+	bool ProcessCrowdPush(int32 Index, float DeltaTime);
+
+	// Separation from neighbors + crowd push received from neighbors behind us.
+	// Thread-safe: reads shared arrays, writes only SeparationInputs/CrowdPushInputs[Index].
+	void GatherSeparation(int32 Index, const FVector2f& PlayerPosition, bool bHasPlayer);
+
+	// Game thread: apply the gathered separation input and crowd push
+	void CommitSeparation(int32 Index);
+
+	// Chase input (flow field, or straight at the player up close) and face-the-player rotation
+	void ProcessChase(int32 Index, const FVector& PlayerLocation, bool bFacePlayer);
+
+	// Integrate accumulated input for kinematic enemies and write the final transform
+	void ProcessKinematicMove(int32 Index, float DeltaTime, const FVector& PlayerLocation, bool bFacePlayer);
+
+	// Route movement input to CharacterMovement, or to MoveInputs for kinematic enemies
+	void AddMoveInput(int32 Index, const FVector& Input);
+
+	// Resting Z for a kinematic enemy: top of the LevelFloor plus capsule half-height
+	float ComputeFloorZ(const ASurvivorEnemy* Enemy) const;
+
+	void ProcessHitFlash(int32 Index, float DeltaTime, bool bOnScreen);
+
+	// One grid query around the player: tick attack cooldowns of enemies in range and
+	// apply every attack that comes due this step as a single damage batch
+	void ResolveContactDamage(float DeltaTime, ACharacter* Player);
+
+	// Hit flash to the instance custom data, or to the enemy's own material
+	void PushHitFlashVisual(int32 Index, float Intensity);
+
+	// Copy final transforms of instanced enemies into their render batches
+	void SyncRenderInstances();
+
+	// Classify every enemy into a simulation LOD tier (frustum + distance)
+	void UpdateLODTiers();
+
+	// Steps between full updates for a tier (1 = every step)
+	int32 GetUpdateInterval(EHordeSimLOD Tier) const;
+
+	// Does this enemy recompute separation and steering this step?
+	bool ShouldFullUpdate(int32 Index) const;
+
+	void RemoveAtSwap(int32 Index);
+	void FlushPendingRemovals();
+
+	// True while StepHorde is iterating; removals are deferred to keep indices stable
+	bool bIsStepping = false;
+	TArray<int32> PendingRemovals;
+
+	// LevelFloor bounds (shrunk by the wall margin) for clamping kinematic enemies; refreshed each step
+	FBox MoverBounds;
+	bool bHasMoverBounds = false;
+
+	// Rebuilt from our arrays at the start of every step; item index == HordeIndex
+	UPROPERTY()
+	UEnemySpatialGridSubsystem* SpatialGrid;
+
+	// Shared steering field toward the player; retargeted at the start of every step
+	UPROPERTY()
+	UFlowFieldSubsystem* FlowField;
+
+	// Instanced drawing for enemies with bUseInstancedRendering; flushed after every step
+	UPROPERTY()
+	UHordeRenderSubsystem* RenderSubsystem;
+
+	// Actorless projectiles; stepped after the horde so both share one instance flush
+	UPROPERTY()
+	UProjectileSimulationSubsystem* ProjectileSimulation;
+
+	// ===== Structure of arrays (all indexed by ASurvivorEnemy::HordeIndex) =====
+
+	UPROPERTY()
+	TArray<ASurvivorEnemy*> Enemies;
+
+	TArray<FVector> Positions;
+
+	// Scratch: each enemy's handle at grid rebuild, so grid users can tell recycled entries apart
+	TArray<FEnemyHandle> GridHandles;
+	TArray<FVector> KnockbackVelocities;
+	TArray<FVector> CrowdPushVelocities;
+	TArray<float> HitFlashIntensities;
+	TArray<float> HitFlashHoldTimers;
+	TArray<float> KnockbackMasses;
+	TArray<float> MaxWalkSpeeds;
+	TArray<float> HealthFractions;
+
+	// Contact damage: per-attack damage, time until the next attack, and the last step the
+	// enemy was in range (a gap means it left and re-entered, which resets the cooldown)
+	TArray<float> AttackDamages;
+	TArray<float> AttackCooldowns;
+	TArray<uint32> LastContactSteps;
+
+	// Kinematic mover state (unused for CharacterMovement-driven enemies)
+	TArray<bool> KinematicFlags;
+	TArray<bool> ClampToFloorFlags;  // ASurvivorEnemy::bClampToFloorBounds
+	TArray<FVector> Velocities;
+	TArray<FVector> MoveInputs;
+	TArray<float> MaxAccelerations;
+	TArray<float> FloorHeights;
+
+	// Pool slot per enemy (indexes the knockback chain bitmask)
+	TArray<int32> PoolSlots;
+
+	// Row in ChainHitBits for an enemy's current knockback chain (INDEX_NONE = no chain)
+	TArray<int32> ChainRows;
+
+	// Enemies already transferred momentum to in each chain (prevents double-hits).
+	// Flat rows of ChainRowWords words; rows are recycled through FreeChainRows, so
+	// steady-state knockback does no heap allocation.
+	TArray<uint64> ChainHitBits;
+	TArray<int32> FreeChainRows;
+	int32 ChainRowWords = 0;
+	int32 NumChainRows = 0;
+
+	// Movement input from the last full update (separation + chase), re-applied every step
+	TArray<FVector> MoveIntents;
+
+	// Hit flash value last pushed to the material (offscreen enemies fall behind, then resync)
+	TArray<float> HitFlashVisuals;
+
+	TArray<EHordeSimLOD> LODTiers;
+
+	// Instance in UHordeRenderSubsystem (INDEX_NONE = drawn by the enemy's own mesh)
+	TArray<int32> RenderBatches;
+	TArray<int32> RenderInstances;
+
+	// LOD update cadence for this step (copied from UEnemySpawnSubsystem)
+	uint32 StepCounter = 0;
+	int32 NearOffscreenInterval = 1;
+	int32 FarOffscreenInterval = 1;
+
+	// Per-step gather accumulators (sized to the enemy count each step, not swap-removed)
+	TArray<FVector> SeparationInputs;
+	TArray<FVector> CrowdPushInputs;
+	TArray<float> PlayerDistances;
+	TArray<FArmoredHit> ContactHits;
+};
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+
+// Horde performance counters. View in game with "stat Horde".
+DECLARE_STATS_GROUP(TEXT("Horde"), STATGROUP_Horde, STATCAT_Advanced);
+
+// Enemy meshes/materials that had to be loaded synchronously on spawn (should stay at 0)
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Enemy Sync Loads"), STAT_EnemySyncLoads, STATGROUP_Horde, FIRSTHORDESURVIVOR_API);
+
+// Enemy types with async asset loads still in flight
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Enemy Types Streaming"), STAT_EnemyTypesStreaming, STATGROUP_Horde, FIRSTHORDESURVIVOR_API);
+
+// Enemies spawned synchronously because the pool had no headroom left (should stay at 0)
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Enemy Pool Sync Spawns"), STAT_EnemyPoolSyncSpawns, STATGROUP_Horde, FIRSTHORDESURVIVOR_API);
+
+// Overlapping component pairs in the world, sampled by the DebugCountOverlaps console command
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Overlap Pairs"), STAT_OverlapPairs, STATGROUP_Horde, FIRSTHORDESURVIVOR_API);
+
+// Projectiles handed out from the pool vs. spawned because the class's pool was empty
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Projectile Pool Hits"), STAT_ProjectilePoolHits, STATGROUP_Horde, FIRSTHORDESURVIVOR_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Projectile Pool Misses"), STAT_ProjectilePoolMisses, STATGROUP_Horde, FIRSTHORDESURVIVOR_API);
+
+// Projectiles in flight in UProjectileSimulationSubsystem (actorless)
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Simulated Projectiles"), STAT_SimulatedProjectiles, STATGROUP_Horde, FIRSTHORDESURVIVOR_API);
@@ -0,0 +1,96 @@
+#include "ProjectilePoolSubsystem.h"
+#include "SurvivorProjectile.h"
+#include "Engine/World.h"
+
+void UProjectilePoolSubsystem::Deinitialize()
+{
+	// Actors are cleaned up by the world
+	Pools.Empty();
+
+	Super::Deinitialize();
+}
+
+bool UProjectilePoolSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	// Only create for game worlds, not editor preview
+	UWorld* World = Cast<UWorld>(Outer);
+	return World && World->IsGameWorld();
+}
+
+FProjectilePool& UProjectilePoolSubsystem::FindOrAddPool(UClass* Class)
+{
+	if (FProjectilePool* Pool = Pools.Find(Class))
+	{
+		return *Pool;
+	}
+
+	FProjectilePool& Pool = Pools.Add(Class);
+	Pool.MaxSize = DefaultPoolSize;
+	return Pool;
+}
+
+void UProjectilePoolSubsystem::SetPoolSize(TSubclassOf<ASurvivorProjectile> Class, int32 PoolSize)
+{
+	if (!Class)
+	{
+		return;
+	}
+
+	FProjectilePool* Pool = Pools.Find(Class);
+	if (!Pool)
+	{
+		Pools.Add(Class).MaxSize = FMath::Max(PoolSize, 0);
+	}
+	else
+	{
+		Pool->MaxSize = FMath::Max(Pool->MaxSize, PoolSize);
+	}
+}
+
+ASurvivorProjectile* UProjectilePoolSubsystem::AcquireProjectile(TSubclassOf<ASurvivorProjectile> Class, const FTransform& Transform, APawn* Instigator)
+{
+	if (!Class)
+	{
+		return nullptr;
+	}
+
+	FProjectilePool& Pool = FindOrAddPool(Class);
+	while (Pool.Inactive.Num() > 0)
+	{
+		ASurvivorProjectile* Projectile = Pool.Inactive.Pop(EAllowShrinking::No);
+		if (IsValid(Projectile))
+		{
+			INC_DWORD_STAT(STAT_ProjectilePoolHits);
+			NumPoolHits++;
+			Projectile->Activate(Transform, Instigator);
+			return Projectile;
+		}
+	}
+
+	// Pool empty - spawn a new one (BeginPlay arms it like Activate does)
+	INC_DWORD_STAT(STAT_ProjectilePoolMisses);
+	NumPoolMisses++;
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	SpawnParams.Instigator = Instigator;
+	return GetWorld()->SpawnActor<ASurvivorProjectile>(Class, Transform, SpawnParams);
+}
+
+void UProjectilePoolSubsystem::ReleaseProjectile(ASurvivorProjectile* Projectile)
+{
+	if (!IsValid(Projectile) || Projectile->IsInPool())
+	{
+		return;
+	}
+
+	FProjectilePool& Pool = FindOrAddPool(Projectile->GetClass());
+	if (Pool.Inactive.Num() >= Pool.MaxSize)
+	{
+		Projectile->Destroy();
+		return;
+	}
+
+	Projectile->Deactivate();
+	Pool.Inactive.Add(Projectile);
+}
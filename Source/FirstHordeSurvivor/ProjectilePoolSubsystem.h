@@ -0,0 +1,66 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "HordeStats.h"
+#include "ProjectilePoolSubsystem.generated.h"
+
+class ASurvivorProjectile;
+
+// Inactive projectiles of one class
+USTRUCT()
+struct FProjectilePool
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<ASurvivorProjectile*> Inactive;
+
+	// Inactive projectiles kept; releases beyond this are destroyed
+	int32 MaxSize = 0;
+};
+
+/**
+ * WorldSubsystem that recycles projectile actors instead of spawning one per shot and
+ * destroying it on hit, like UXPGemSubsystem does for gems.
+ *
+ * One pool per projectile class. Pool size comes from the weapons using the class
+ * (UProjectileWeaponData::ProjectilePoolSize, largest wins). Hits and misses are counted
+ * in STAT_ProjectilePoolHits / STAT_ProjectilePoolMisses; misses should stop once the
+ * pools have filled up to the steady-state number of projectiles in flight.
+ */
+UCLASS()
+class FIRSTHORDESURVIVOR_API UProjectilePoolSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// USubsystem interface
+	virtual void Deinitialize() override;
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+
+	// Active projectile of Class at Transform (spawned on a pool miss). Call Initialize on it next.
+	ASurvivorProjectile* AcquireProjectile(TSubclassOf<ASurvivorProjectile> Class, const FTransform& Transform, APawn* Instigator);
+
+	// Deactivate and pool (destroyed instead if the class's pool is full). Safe to call twice.
+	void ReleaseProjectile(ASurvivorProjectile* Projectile);
+
+	// Keep up to PoolSize inactive projectiles of Class (never shrinks an existing pool)
+	void SetPoolSize(TSubclassOf<ASurvivorProjectile> Class, int32 PoolSize);
+
+	int32 GetNumPoolHits() const { return NumPoolHits; }
+	int32 GetNumPoolMisses() const { return NumPoolMisses; }
+
+	// Pool size for classes no weapon has sized
+	UPROPERTY(EditAnywhere, Category = "Pool")
+	int32 DefaultPoolSize = 64;
+
+protected:
+	FProjectilePool& FindOrAddPool(UClass* Class);
+
+	UPROPERTY()
+	TMap<UClass*, FProjectilePool> Pools;
+
+	int32 NumPoolHits = 0;
+	int32 NumPoolMisses = 0;
+};
@@ -0,0 +1,379 @@
+#include "ProjectileSimulationSubsystem.h"
+#include "SurvivorProjectile.h"
+#include "SurvivorEnemy.h"
+#include "EnemySpatialGridSubsystem.h"
+#include "EnemySpawnSubsystem.h"
+#include "HordeRenderSubsystem.h"
+#include "EnemyTuning.h"
+#include "AttributeComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "Kismet/GameplayStatics.h"
+#include "NiagaraFunctionLibrary.h"
+#include "Engine/World.h"
+
+void UProjectileSimulationSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	SpatialGrid = Collection.InitializeDependency<UEnemySpatialGridSubsystem>();
+	SpawnSubsystem = Collection.InitializeDependency<UEnemySpawnSubsystem>();
+	RenderSubsystem = Collection.InitializeDependency<UHordeRenderSubsystem>();
+}
+
+void UProjectileSimulationSubsystem::Deinitialize()
+{
+	Projectiles.Empty();
+	ProjectileTypes.Empty();
+	SweepHits.Empty();
+	WallHits.Empty();
+	ExplosionTargets.Empty();
+	ExplosionAttributes.Empty();
+	ExplosionPositions.Empty();
+	SpatialGrid = nullptr;
+	SpawnSubsystem = nullptr;
+	RenderSubsystem = nullptr;
+
+	Super::Deinitialize();
+}
+
+bool UProjectileSimulationSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	// Only create for game worlds, not editor preview
+	UWorld* World = Cast<UWorld>(Outer);
+	return World && World->IsGameWorld();
+}
+
+int32 UProjectileSimulationSubsystem::FindOrAddType(UClass* ProjectileClass, USoundBase* InImpactSound, UNiagaraSystem* InImpactVFX,
+	USoundBase* InExplosionSound, UNiagaraSystem* InExplosionVFX)
+{
+	// DataAsset impact effects override Blueprint defaults if provided
+	const ASurvivorProjectile* Defaults = ProjectileClass->GetDefaultObject<ASurvivorProjectile>();
+	USoundBase* ImpactSound = InImpactSound ? InImpactSound : Defaults->GetHitSound();
+	UNiagaraSystem* ImpactVFX = InImpactVFX ? InImpactVFX : Defaults->GetHitVFX();
+
+	// Only a handful of weapons exist, a linear search is fine
+	for (int32 Index = 0; Index < ProjectileTypes.Num(); ++Index)
+	{
+		const FSimProjectileType& Type = ProjectileTypes[Index];
+		if (Type.ProjectileClass == ProjectileClass && Type.ImpactSound == ImpactSound && Type.ImpactVFX == ImpactVFX
+			&& Type.ExplosionSound == InExplosionSound && Type.ExplosionVFX == InExplosionVFX)
+		{
+			return Index;
+		}
+	}
+
+	FSimProjectileType& Type = ProjectileTypes.AddDefaulted_GetRef();
+	Type.ProjectileClass = ProjectileClass;
+	Type.CollisionRadius = Defaults->GetCollisionRadius();
+	if (const UStaticMeshComponent* MeshComp = Defaults->GetMeshComponent())
+	{
+		Type.Mesh = MeshComp->GetStaticMesh();
+		Type.Material = MeshComp->GetMaterial(0);
+		Type.MeshTransform = MeshComp->GetRelativeTransform();
+	}
+	Type.ImpactSound = ImpactSound;
+	Type.ImpactVFX = ImpactVFX;
+	Type.ExplosionSound = InExplosionSound;
+	Type.ExplosionVFX = InExplosionVFX;
+	return ProjectileTypes.Num() - 1;
+}
+
+void UProjectileSimulationSubsystem::LaunchProjectile(
+	TSubclassOf<ASurvivorProjectile> ProjectileClass,
+	const FVector& Location,
+	const FVector& Direction,
+	float Speed,
+	float DamageAmount,
+	float Range,
+	int32 PierceCount,
+	float ExplosionRadius,
+	float KnockbackForce,
+	USoundBase* InImpactSound,
+	UNiagaraSystem* InImpactVFX,
+	USoundBase* InExplosionSound,
+	UNiagaraSystem* InExplosionVFX)
+{
+	if (!ProjectileClass)
+	{
+		return;
+	}
+
+	FSimProjectile& Projectile = Projectiles.AddDefaulted_GetRef();
+	Projectile.Location = Location;
+	Projectile.Direction = FVector(Direction.X, Direction.Y, 0.0f).GetSafeNormal();
+	Projectile.Speed = Speed;
+	Projectile.RemainingRange = Range;
+	Projectile.Damage = DamageAmount;
+	Projectile.AoERadius = ExplosionRadius;
+	Projectile.Knockback = KnockbackForce;
+	Projectile.RemainingPierces = PierceCount;
+	Projectile.Type = FindOrAddType(ProjectileClass, InImpactSound, InImpactVFX, InExplosionSound, InExplosionVFX);
+
+	const FSimProjectileType& Type = ProjectileTypes[Projectile.Type];
+	if (!RenderSubsystem || !RenderSubsystem->AcquireInstance(Type.Mesh, Type.Material,
+		Type.MeshTransform * FTransform(Projectile.Direction.Rotation(), Location),
+		FLinearColor::White, 0.0f, Projectile.RenderBatch, Projectile.RenderInstance))
+	{
+		Projectile.RenderBatch = INDEX_NONE;
+		Projectile.RenderInstance = INDEX_NONE;
+	}
+}
+
+void UProjectileSimulationSubsystem::StepProjectiles(float DeltaTime)
+{
+	SET_DWORD_STAT(STAT_SimulatedProjectiles, Projectiles.Num());
+	if (Projectiles.Num() == 0)
+	{
+		return;
+	}
+
+	// Backwards so a spent projectile can be swap-removed in place
+	for (int32 Index = Projectiles.Num() - 1; Index >= 0; --Index)
+	{
+		if (!StepProjectile(Projectiles[Index], DeltaTime))
+		{
+			RemoveProjectile(Index);
+		}
+	}
+}
+
+bool UProjectileSimulationSubsystem::StepProjectile(FSimProjectile& Projectile, float DeltaTime)
+{
+	const FSimProjectileType& Type = ProjectileTypes[Projectile.Type];
+	const float Travel = FMath::Min(Projectile.Speed * DeltaTime, Projectile.RemainingRange);
+	const FVector Start = Projectile.Location;
+	const FVector End = Start + Projectile.Direction * Travel;
+
+	// Walls stop the projectile; only enemies reached before the wall are hit
+	float WallAlong = 0.0f;
+	FVector WallLocation = End;
+	const bool bHitWall = Travel > 0.0f && SweepForWall(Start, End, Type.CollisionRadius, WallAlong, WallLocation);
+
+	// Everyone the projectile's sphere touches along this frame's segment (sphere vs. enemy body, flat)
+	if (SpatialGrid)
+	{
+		const FVector2f Start2D = UEnemySpatialGridSubsystem::ToGridPosition(Start);
+		const FVector2f Segment = UEnemySpatialGridSubsystem::ToGridPosition(End) - Start2D;
+		const float SegmentLengthSq = Segment.SizeSquared();
+		const float HitRadius = Type.CollisionRadius + KnockbackSettings::EnemyBodyRadius;
+		const float HitRadiusSq = HitRadius * HitRadius;
+
+		SweepHits.Reset();
+		SpatialGrid->ForEachInRadius(Start2D + Segment * 0.5f, Travel * 0.5f + HitRadius,
+			[&](int32 ItemIndex, const FVector2f& ItemPosition, float DistSq)
+		{
+			const float Along = SegmentLengthSq > 0.0f
+				? FMath::Clamp(FVector2f::DotProduct(ItemPosition - Start2D, Segment) / SegmentLengthSq, 0.0f, 1.0f)
+				: 0.0f;
+			if (FVector2f::DistSquared(Start2D + Segment * Along, ItemPosition) <= HitRadiusSq)
+			{
+				SweepHits.Emplace(Along, ItemIndex);
+			}
+		});
+
+		// Resolve in the order the projectile reaches them, so pierce stops at the right enemy
+		SweepHits.Sort([](const TPair<float, int32>& A, const TPair<float, int32>& B) { return A.Key < B.Key; });
+
+		for (const TPair<float, int32>& Hit : SweepHits)
+		{
+			if (bHitWall && Hit.Key > WallAlong)
+			{
+				break;
+			}
+
+			// Grid is built at the start of the horde step; skip anyone who died since, including
+			// enemies recycled into a new life elsewhere (their current handle no longer matches)
+			ASurvivorEnemy* Enemy = SpatialGrid->GetEnemy(Hit.Value);
+			const FEnemyHandle Handle = SpatialGrid->GetHandle(Hit.Value);
+			if (!Handle.IsSet() || !SpawnSubsystem || SpawnSubsystem->GetEnemyHandle(Enemy) != Handle
+				|| Projectile.HitEnemies.Contains(Handle))
+			{
+				continue;
+			}
+
+			// Track that we directly hit this enemy (prevents re-hitting same enemy)
+			Projectile.HitEnemies.Add(Handle);
+
+			const FVector HitLocation = FMath::Lerp(Start, End, Hit.Key);
+			DamageEnemy(Projectile, Enemy, HitLocation);
+
+			// Effects based on whether this is an explosive or single-target projectile
+			if (Projectile.AoERadius > 0.0f)
+			{
+				// Explosive projectile - damage nearby enemies (they can be hit by future explosions)
+				Explode(Projectile, HitLocation, Enemy);
+			}
+			else
+			{
+				// Single-target projectile - play hit effects
+				if (Type.ImpactSound)
+				{
+					UGameplayStatics::PlaySoundAtLocation(this, Type.ImpactSound, HitLocation);
+				}
+				if (Type.ImpactVFX)
+				{
+					UNiagaraFunctionLibrary::SpawnSystemAtLocation(this, Type.ImpactVFX, HitLocation);
+				}
+			}
+
+			// Pierce logic applies to both AoE and non-AoE projectiles
+			if (Projectile.RemainingPierces > 0)
+			{
+				Projectile.RemainingPierces--;
+			}
+			else
+			{
+				return false;
+			}
+		}
+	}
+
+	// Hit a wall - explode if applicable
+	if (bHitWall)
+	{
+		if (Projectile.AoERadius > 0.0f)
+		{
+			Explode(Projectile, WallLocation, nullptr);
+		}
+		return false;
+	}
+
+	Projectile.Location = End;
+	Projectile.RemainingRange -= Travel;
+
+	// Range Check - explosive projectiles explode at end of range
+	if (Projectile.RemainingRange <= 0.0f)
+	{
+		if (Projectile.AoERadius > 0.0f)
+		{
+			Explode(Projectile, End, nullptr);
+		}
+		return false;
+	}
+
+	if (Projectile.RenderBatch != INDEX_NONE)
+	{
+		RenderSubsystem->SetInstanceTransform(Projectile.RenderBatch, Projectile.RenderInstance,
+			Type.MeshTransform * FTransform(Projectile.Direction.Rotation(), End));
+	}
+	return true;
+}
+
+bool UProjectileSimulationSubsystem::SweepForWall(const FVector& Start, const FVector& End, float Radius, float& OutAlong, FVector& OutLocation)
+{
+	// Object queries report every WorldStatic body along the way (sorted by time), so untagged
+	// geometry such as the floor doesn't hide a wall behind it
+	const FCollisionObjectQueryParams ObjectParams(ECC_WorldStatic);
+	const FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(ProjectileWallSweep), false);
+
+	WallHits.Reset();
+	GetWorld()->SweepMultiByObjectType(WallHits, Start, End, FQuat::Identity, ObjectParams,
+		FCollisionShape::MakeSphere(Radius), QueryParams);
+
+	for (const FHitResult& Hit : WallHits)
+	{
+		const AActor* HitActor = Hit.GetActor();
+		if (HitActor && HitActor->ActorHasTag("WorldStatic"))
+		{
+			OutAlong = Hit.Time;
+			OutLocation = Hit.bStartPenetrating ? Start : Hit.Location;
+			return true;
+		}
+	}
+	return false;
+}
+
+void UProjectileSimulationSubsystem::DamageEnemy(const FSimProjectile& Projectile, ASurvivorEnemy* Enemy, const FVector& HitLocation)
+{
+	if (Enemy->AttributeComp)
+	{
+		Enemy->AttributeComp->ApplyHealthChange(-Projectile.Damage);
+	}
+
+	if (Projectile.Knockback <= 0.0f)
+	{
+		return;
+	}
+
+	// Direction from projectile to target, horizontal
+	FVector KnockbackDir = Enemy->GetActorLocation() - HitLocation;
+	KnockbackDir.Z = 0.0f;
+	KnockbackDir.Normalize();
+
+	// Scale knockback by enemy's HP-based resistance (lighter = more knockback)
+	Enemy->ApplyKnockback(KnockbackDir * (Projectile.Knockback * Enemy->GetKnockbackResistance()));
+}
+
+void UProjectileSimulationSubsystem::Explode(const FSimProjectile& Projectile, const FVector& Location, const ASurvivorEnemy* DirectHit)
+{
+	// Play explosion effects
+	const FSimProjectileType& Type = ProjectileTypes[Projectile.Type];
+	if (Type.ExplosionSound)
+	{
+		UGameplayStatics::PlaySoundAtLocation(this, Type.ExplosionSound, Location);
+	}
+	if (Type.ExplosionVFX)
+	{
+		UNiagaraFunctionLibrary::SpawnSystemAtLocation(this, Type.ExplosionVFX, Location);
+	}
+
+	ApplyExplosionDamage(Location, Projectile.AoERadius, Projectile.Damage, Projectile.Knockback, DirectHit);
+}
+
+void UProjectileSimulationSubsystem::ApplyExplosionDamage(const FVector& Location, float Radius, float Damage, float Knockback, const ASurvivorEnemy* DirectHit)
+{
+	if (!SpatialGrid)
+	{
+		return;
+	}
+
+	// Everyone whose body reaches into the radius, except the direct hit (already damaged).
+	// Collected first: damage can kill, and death callbacks should not run mid-query.
+	// Entries whose handle changed since the grid was built died (and may have respawned elsewhere).
+	const FVector2f Center = UEnemySpatialGridSubsystem::ToGridPosition(Location);
+	ExplosionTargets.Reset();
+	ExplosionAttributes.Reset();
+	ExplosionPositions.Reset();
+	SpatialGrid->ForEachInRadius(Center, Radius + KnockbackSettings::EnemyBodyRadius,
+		[&](int32 ItemIndex, const FVector2f& ItemPosition, float DistSq)
+	{
+		ASurvivorEnemy* Enemy = SpatialGrid->GetEnemy(ItemIndex);
+		const FEnemyHandle Handle = SpatialGrid->GetHandle(ItemIndex);
+		if (Enemy != DirectHit && Handle.IsSet() && SpawnSubsystem && SpawnSubsystem->GetEnemyHandle(Enemy) == Handle)
+		{
+			ExplosionTargets.Add(Enemy);
+			ExplosionAttributes.Add(SpatialGrid->GetAttributes(ItemIndex));
+			ExplosionPositions.Add(ItemPosition);
+		}
+	});
+
+	if (ExplosionTargets.Num() == 0)
+	{
+		return;
+	}
+
+	UAttributeComponent::ApplyHealthChangeBatch(ExplosionAttributes, -Damage);
+
+	if (Knockback <= 0.0f)
+	{
+		return;
+	}
+
+	// Push away from the blast center (grid positions, flat), scaled by each enemy's HP-based resistance
+	for (int32 Index = 0; Index < ExplosionTargets.Num(); ++Index)
+	{
+		const FVector2f Dir = (ExplosionPositions[Index] - Center).GetSafeNormal();
+		ASurvivorEnemy* Enemy = ExplosionTargets[Index];
+		Enemy->ApplyKnockback(FVector(Dir.X, Dir.Y, 0.0f) * (Knockback * Enemy->GetKnockbackResistance()));
+	}
+}
+
+void UProjectileSimulationSubsystem::RemoveProjectile(int32 Index)
+{
+	const FSimProjectile& Projectile = Projectiles[Index];
+	if (Projectile.RenderBatch != INDEX_NONE && RenderSubsystem)
+	{
+		RenderSubsystem->ReleaseInstance(Projectile.RenderBatch, Projectile.RenderInstance);
+	}
+	Projectiles.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+}
@@ -0,0 +1,159 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "EnemyHandle.h"
+#include "HordeStats.h"
+#include "Engine/HitResult.h"
+#include "ProjectileSimulationSubsystem.generated.h"
+
+class ASurvivorProjectile;
+class ASurvivorEnemy;
+class UEnemySpatialGridSubsystem;
+class UEnemySpawnSubsystem;
+class UHordeRenderSubsystem;
+class UStaticMesh;
+class UMaterialInterface;
+class USoundBase;
+class UNiagaraSystem;
+class UAttributeComponent;
+
+// Everything shared by projectiles fired from the same class with the same effects.
+// Read once from the ASurvivorProjectile class default object (mesh, sphere radius, hit effects).
+USTRUCT()
+struct FSimProjectileType
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	UClass* ProjectileClass = nullptr;
+
+	UPROPERTY()
+	UStaticMesh* Mesh = nullptr;
+
+	UPROPERTY()
+	UMaterialInterface* Material = nullptr;
+
+	// Mesh relative to the projectile root
+	FTransform MeshTransform;
+
+	float CollisionRadius = 0.0f;
+
+	// Resolved: DataAsset override, else the Blueprint's HitSound/HitVFX
+	UPROPERTY()
+	USoundBase* ImpactSound = nullptr;
+
+	UPROPERTY()
+	UNiagaraSystem* ImpactVFX = nullptr;
+
+	UPROPERTY()
+	USoundBase* ExplosionSound = nullptr;
+
+	UPROPERTY()
+	UNiagaraSystem* ExplosionVFX = nullptr;
+};
+
+/**
+ * WorldSubsystem that simulates player projectiles as plain structs instead of
+ * actors (no sphere component, movement component or per-projectile Tick).
+ *
+ * Every frame one loop advances all projectiles. UHordeSimulationSubsystem runs it right
+ * after the horde step, so enemy and projectile instances share a single FlushInstances. Each projectile sweeps the segment it
+ * travelled against the enemy spatial grid, so fast projectiles cannot tunnel through an
+ * enemy between frames. Hits are resolved in order along the segment with the same rules
+ * as ASurvivorProjectile: damage and knockback to the direct hit, explosion (everyone in
+ * radius except the direct hit) or impact effects, then pierce or stop; exploding at the
+ * end of range or on a wall (the same segment swept against WorldStatic). Meshes are drawn as instances through UHordeRenderSubsystem.
+ */
+UCLASS()
+class FIRSTHORDESURVIVOR_API UProjectileSimulationSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// USubsystem interface
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+
+	// Advance every projectile one frame (called by UHordeSimulationSubsystem before it flushes instances)
+	void StepProjectiles(float DeltaTime);
+
+	// Same parameters as ASurvivorProjectile::Initialize, plus where and which way to fly
+	void LaunchProjectile(
+		TSubclassOf<ASurvivorProjectile> ProjectileClass,
+		const FVector& Location,
+		const FVector& Direction,
+		float Speed,
+		float DamageAmount,
+		float Range,
+		int32 PierceCount = 0,
+		float ExplosionRadius = 0.0f,
+		float KnockbackForce = 0.0f,
+		USoundBase* InImpactSound = nullptr,
+		UNiagaraSystem* InImpactVFX = nullptr,
+		USoundBase* InExplosionSound = nullptr,
+		UNiagaraSystem* InExplosionVFX = nullptr
+	);
+
+	int32 GetNumProjectiles() const { return Projectiles.Num(); }
+
+	// Damage and knock back every active enemy whose body reaches into Radius of Location, except
+	// DirectHit: one spatial grid query and one batched damage call. Shared with ASurvivorProjectile.
+	void ApplyExplosionDamage(const FVector& Location, float Radius, float Damage, float Knockback, const ASurvivorEnemy* DirectHit);
+
+protected:
+	struct FSimProjectile
+	{
+		FVector Location;
+		FVector Direction;  // Unit, flat
+		float Speed;
+		float RemainingRange;
+		float Damage;
+		float AoERadius;
+		float Knockback;
+		int32 RemainingPierces;
+		int32 Type;  // Index into ProjectileTypes
+		int32 RenderBatch;
+		int32 RenderInstance;
+
+		// Enemies already hit (pierce); handles so a recycled enemy counts as new
+		TArray<FEnemyHandle, TInlineAllocator<4>> HitEnemies;
+	};
+
+	int32 FindOrAddType(UClass* ProjectileClass, USoundBase* InImpactSound, UNiagaraSystem* InImpactVFX,
+		USoundBase* InExplosionSound, UNiagaraSystem* InExplosionVFX);
+
+	// Advance one projectile and resolve its hits. Returns false once it is spent.
+	bool StepProjectile(FSimProjectile& Projectile, float DeltaTime);
+
+	// First actor tagged "WorldStatic" (a wall, as in ASurvivorProjectile::OnOverlapBegin) the sphere
+	// touches between Start and End. OutAlong is the position along the segment (0-1).
+	bool SweepForWall(const FVector& Start, const FVector& End, float Radius, float& OutAlong, FVector& OutLocation);
+
+	void DamageEnemy(const FSimProjectile& Projectile, ASurvivorEnemy* Enemy, const FVector& HitLocation);
+	void Explode(const FSimProjectile& Projectile, const FVector& Location, const ASurvivorEnemy* DirectHit);
+	void RemoveProjectile(int32 Index);
+
+	UPROPERTY()
+	UEnemySpatialGridSubsystem* SpatialGrid;
+
+	UPROPERTY()
+	UEnemySpawnSubsystem* SpawnSubsystem;
+
+	UPROPERTY()
+	UHordeRenderSubsystem* RenderSubsystem;
+
+	UPROPERTY()
+	TArray<FSimProjectileType> ProjectileTypes;
+
+	// Unordered; swap-removed when spent
+	TArray<FSimProjectile> Projectiles;
+
+	// Scratch reused between projectiles: (position along the segment 0-1, grid item)
+	TArray<TPair<float, int32>> SweepHits;
+	TArray<FHitResult> WallHits;
+	TArray<ASurvivorEnemy*> ExplosionTargets;
+	TArray<UAttributeComponent*> ExplosionAttributes;
+	TArray<FVector2f> ExplosionPositions;
+};
@@ -40,6 +40,16 @@ public:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Projectile", meta = (ClampMin = "1"))
 	float BaseRPM = 60.0f;
 
+	// Inactive projectile actors of ProjectileClass kept for reuse (bUseProjectileActors; largest value among weapons sharing the class wins)
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Projectile", meta = (ClampMin = "0"))
+	int32 ProjectilePoolSize = 64;
+
+	// Spawn pooled ASurvivorProjectile actors instead of the batched projectile simulation.
+	// Clear per weapon to opt into the simulation; keep it for Blueprint-scripted projectiles or the
+	// Niagara trail (the simulation draws the mesh only).
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Projectile")
+	bool bUseProjectileActors = true;
+
 	// ===== Projectile Stats =====
 
 	// Projectile travel speed (units/second)
@@ -94,6 +104,11 @@ public:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Targeting", meta = (ClampMin = "0"))
 	float InFrontWeight = 1000.0f;
 
+	// Score subtracted per live claim other weapons hold on a target; this weapon's own shots don't count.
+	// 0 = off (may focus the same enemy as other weapons); ~250 spreads weapons across targets.
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Targeting", meta = (ClampMin = "0"))
+	float TargetSpreadPenalty = 0.0f;
+
 	// ===== Impact Visuals (single-target hit, non-AoE) =====
 
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Visuals|Impact")
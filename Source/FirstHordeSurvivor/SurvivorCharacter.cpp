@@ -12,6 +12,9 @@
 #include "SurvivorWeapon.h"
 #include "WeaponDataBase.h"
 #include "UpgradeSubsystem.h"
+#include "HordeSeparationKernel.h"
+#include "HordeStats.h"
+#include "EngineUtils.h"
 
 #include "Components/StaticMeshComponent.h"
 
@@ -392,6 +395,40 @@ void ASurvivorCharacter::DebugKillNearby()
     }
 }
 
+void ASurvivorCharacter::DebugBenchSeparation(int32 NumNeighbors, int32 Iterations)
+{
+    // Typical dense-horde neighborhood and enough iterations to swamp timer noise
+    HordeSeparationKernel::RunBenchmark(
+        NumNeighbors > 0 ? NumNeighbors : 32,
+        Iterations > 0 ? Iterations : 200000);
+}
+
+void ASurvivorCharacter::DebugCountOverlaps()
+{
+    // Every overlap is recorded on both components, so halve the total
+    int32 NumOverlapComponents = 0;
+    int32 NumOverlapEntries = 0;
+    int32 NumEnemies = 0;
+    for (TActorIterator<AActor> It(GetWorld()); It; ++It)
+    {
+        NumEnemies += It->IsA<ASurvivorEnemy>() && !It->IsHidden() ? 1 : 0;
+
+        It->ForEachComponent<UPrimitiveComponent>(false, [&](UPrimitiveComponent* Primitive)
+        {
+            if (Primitive->GetGenerateOverlapEvents() && Primitive->IsCollisionEnabled())
+            {
+                ++NumOverlapComponents;
+                NumOverlapEntries += Primitive->GetOverlapInfos().Num();
+            }
+        });
+    }
+
+    const int32 NumPairs = NumOverlapEntries / 2;
+    SET_DWORD_STAT(STAT_OverlapPairs, NumPairs);
+    UE_LOG(LogTemp, Log, TEXT("Overlaps: %d pairs across %d overlap-enabled components (%d active enemies)"),
+        NumPairs, NumOverlapComponents, NumEnemies);
+}
+
 ASurvivorWeapon* ASurvivorCharacter::AddWeapon(UWeaponDataBase* WeaponData)
 {
     if (!WeaponData)
@@ -114,6 +114,14 @@ public:
     UFUNCTION(Exec)
     void DebugKillNearby();
 
+    // Time the vectorized vs scalar enemy separation kernel (0 = default sizes)
+    UFUNCTION(Exec)
+    void DebugBenchSeparation(int32 NumNeighbors, int32 Iterations);
+
+    // Log (and publish to "stat Horde") how many component overlap pairs the physics scene is tracking
+    UFUNCTION(Exec)
+    void DebugCountOverlaps();
+
     // XP System
     UFUNCTION(BlueprintCallable, Category = "XP")
     void AddXP(int32 Amount);
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineTypes.h"
+
+// Custom object channels and collision profiles.
+// Defined in Config/DefaultEngine.ini [/Script/Engine.CollisionProfile]; the channel
+// slots here must match the ECC_GameTraceChannelN each name is assigned to there.
+namespace SurvivorCollision
+{
+	// Enemy capsules. Blocks world geometry, ignores pawns and other enemies,
+	// overlaps only player projectiles.
+	constexpr ECollisionChannel EnemyBody = ECC_GameTraceChannel1;
+
+	// Player projectile spheres. Overlaps EnemyBody and WorldStatic (walls tagged "WorldStatic"
+	// stop them), ignores everything else.
+	constexpr ECollisionChannel PlayerProjectile = ECC_GameTraceChannel2;
+
+	// XP gems and other pickups. Collected by distance (UXPGemSubsystem), so the profile has no collision.
+	constexpr ECollisionChannel Pickup = ECC_GameTraceChannel3;
+
+	// Profile names (same names as the channels)
+	inline const FName EnemyBodyProfile(TEXT("EnemyBody"));
+	inline const FName PlayerProjectileProfile(TEXT("PlayerProjectile"));
+	inline const FName PickupProfile(TEXT("Pickup"));
+}
@@ -4,79 +4,19 @@
 #include "GameFramework/CharacterMovementComponent.h"
 #include "Components/CapsuleComponent.h"
 #include "Kismet/GameplayStatics.h"
-#include "Kismet/KismetSystemLibrary.h"
 
 #include "Components/StaticMeshComponent.h"
-#include "Components/SphereComponent.h"
-#include "Components/WidgetComponent.h"
+#include "Materials/MaterialInterface.h"
 #include "Materials/MaterialInstanceDynamic.h"
-#include "XPGemSubsystem.h"
 #include "EnemySpawnSubsystem.h"
-#include "Blueprint/UserWidget.h"
-#include "Components/ProgressBar.h"
-#include "Engine/OverlapResult.h"
-
-// Enemy separation tuning constants
-namespace SeparationSettings
-{
-	// Radius within which we push away from other enemies
-	constexpr float SeparationRadius = 150.0f;
-
-	// Max speed added by separation force (units/sec) — gentle, just prevents full overlap
-	constexpr float MaxSeparationSpeed = 400.0f;
-}
-
-// Knockback tuning constants
-namespace KnockbackSettings
-{
-	// How fast knockback decays (units/sec lost per second)
-	constexpr float FrictionDeceleration = 1000.0f;
-
-	// Minimum velocity before knockback stops entirely
-	constexpr float MinVelocityThreshold = 50.0f;
-
-	// How much momentum the pusher retains after hitting another enemy (0.5 = 50%)
-	constexpr float PusherMomentumRetention = 0.9f;
-
-	// How much of the pusher's momentum transfers to the pushed enemy
-	constexpr float MomentumTransferRatio = 0.95f;
-
-	// Radius to check for enemy collisions during knockback
-	constexpr float CollisionCheckRadius = 80.0f;
-
-	// === Initial knockback scaling by enemy HP ===
-
-	// HP at or below this gets full knockback (100%)
-	constexpr float LightEnemyHP = 20.0f;
-
-	// HP at or above this gets minimum knockback
-	constexpr float HeavyEnemyHP = 500.0f;
-
-	// Minimum knockback multiplier for heavy enemies (10% = 0.1)
-	constexpr float MinKnockbackMultiplier = 0.1f;
-}
-
-// Crowd push tuning — enemies behind shove enemies in front toward the player
-namespace CrowdPushSettings
-{
-	// Extra speed (units/sec) a fully-adjacent trailing enemy adds to the front enemy
-	constexpr float MaxPushSpeed = 350.0f;
-
-	// How fast push velocity decays when no longer being pushed (units/sec lost per sec)
-	constexpr float PushDecay = 600.0f;
-}
-
-// Orbital approach tuning
-namespace OrbitSettings
-{
-	// Distance at which enemies stop pushing toward the player.
-	// Should be slightly less than AttackOverlapComp radius (150) so they're in attack range.
-	constexpr float OrbitRadius = 120.0f;
-}
+#include "HordeSimulationSubsystem.h"
+#include "EnemyTuning.h"
+#include "SurvivorCollision.h"
 
 ASurvivorEnemy::ASurvivorEnemy()
 {
-	PrimaryActorTick.bCanEverTick = true;
+	// No per-actor tick: UHordeSimulationSubsystem advances all enemies in one batched pass
+	PrimaryActorTick.bCanEverTick = false;
 
 	AttributeComp = CreateDefaultSubobject<UAttributeComponent>(TEXT("AttributeComp"));
 	AttributeComp->bUseInvulnerability = false;  // Enemies don't get i-frames
@@ -84,33 +24,15 @@ ASurvivorEnemy::ASurvivorEnemy()
 	EnemyMeshComp = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("EnemyMeshComp"));
 	EnemyMeshComp->SetupAttachment(GetCapsuleComponent());
 	// The mesh is visual-only. Disable all collision so it never blocks Pawns
-	// (the capsule owns all physics interaction; AttackOverlapComp owns hit detection).
+	// (the capsule owns all physics interaction; contact damage is resolved centrally by
+	// UHordeSimulationSubsystem from the spatial grid, so there is no attack overlap sphere).
 	EnemyMeshComp->SetCollisionEnabled(ECollisionEnabled::NoCollision);
 
-	AttackOverlapComp = CreateDefaultSubobject<USphereComponent>(TEXT("AttackOverlapComp"));
-	AttackOverlapComp->SetupAttachment(RootComponent);
-	AttackOverlapComp->SetSphereRadius(150.0f); // Larger than capsule to ensure overlap before block
-	AttackOverlapComp->SetCollisionProfileName("OverlapAllDynamic"); // Overlap everything
-	AttackOverlapComp->SetGenerateOverlapEvents(true);
-
-	// Health bar widget
-	HealthBarComp = CreateDefaultSubobject<UWidgetComponent>(TEXT("HealthBarComp"));
-	HealthBarComp->SetupAttachment(RootComponent);
-	HealthBarComp->SetRelativeLocation(FVector(0.0f, 0.0f, 120.0f));
-	HealthBarComp->SetWidgetSpace(EWidgetSpace::Screen);
-	HealthBarComp->SetDrawSize(FVector2D(100.0f, 10.0f));
-
-	// Configure collisions
-	GetCapsuleComponent()->SetCollisionProfileName("Pawn");
-	// Let enemies pass through each other so they can't deadlock/clump.
-	// Separation is handled by a lightweight per-tick push force instead.
-	// ECR_Ignore (vs ECR_Overlap) tells CharacterMovementComponent's internal sweep tests
-	// to completely skip other Pawns, eliminating steering/push interference.
-	GetCapsuleComponent()->SetCollisionResponseToChannel(ECC_Pawn, ECR_Ignore);
-
-	// We want the overlap event to trigger attacks
-	AttackOverlapComp->OnComponentBeginOverlap.AddDynamic(this, &ASurvivorEnemy::OnOverlapBegin);
-	AttackOverlapComp->OnComponentEndOverlap.AddDynamic(this, &ASurvivorEnemy::OnOverlapEnd);
+	// Configure collisions. The EnemyBody profile (DefaultEngine.ini) lets enemies pass through
+	// each other and the player so they can't deadlock/clump; separation is handled by the horde
+	// simulation instead. ECR_Ignore (vs ECR_Overlap) tells CharacterMovementComponent's internal
+	// sweep tests to completely skip other bodies. Only player projectiles overlap the capsule.
+	GetCapsuleComponent()->SetCollisionProfileName(SurvivorCollision::EnemyBodyProfile);
 
 	// Default Movement settings
 	GetCharacterMovement()->bOrientRotationToMovement = true;
@@ -130,11 +52,15 @@ void ASurvivorEnemy::BeginPlay()
 	// Find Player (Simple version for now, assume single player)
 	TargetPlayer = Cast<ASurvivorCharacter>(UGameplayStatics::GetPlayerCharacter(this, 0));
 
-	// Look up enemy data from DataTable
-	if (EnemyDataTable && !EnemyRowName.IsNone())
+	// Look up the compiled enemy type (level-placed enemies; pooled ones get theirs on Reinitialize)
+	UEnemySpawnSubsystem* SpawnSubsystem = GetWorld()->GetSubsystem<UEnemySpawnSubsystem>();
+	if (SpawnSubsystem && EnemyDataTable && !EnemyRowName.IsNone())
 	{
-		EnemyData = EnemyDataTable->FindRow<FEnemyTableRow>(EnemyRowName, TEXT("EnemyLookup"));
+		ArchetypeIndex = SpawnSubsystem->FindOrAddArchetype(EnemyDataTable, EnemyRowName);
+		SpawnSubsystem->ResolveArchetypeAssets(ArchetypeIndex);
 	}
+	const FEnemyArchetype* Archetype = SpawnSubsystem ? SpawnSubsystem->GetArchetype(ArchetypeIndex) : nullptr;
+	EnemyData = Archetype ? Archetype->Row : nullptr;
 
 	// Validate EnemyData (skip warning if row name is empty - likely being pooled/pre-warmed)
 	if (!EnemyData && !EnemyRowName.IsNone())
@@ -147,7 +73,10 @@ void ASurvivorEnemy::BeginPlay()
 	}
 
 	// Initialize Stats
-	InitializeFromData();
+	if (Archetype)
+	{
+		ApplyArchetype(*Archetype);
+	}
 
     // Bind Death and Health Changed
     if (AttributeComp)
@@ -161,295 +90,102 @@ void ASurvivorEnemy::BeginPlay()
         // Initialize last known health for hit flash detection
         LastKnownHealth = AttributeComp->GetCurrentHealth();
     }
-}
 
-void ASurvivorEnemy::InitializeFromData()
-{
+	ApplyMovementMode();
+
+	// Manually placed enemies simulate immediately; pooled ones register on Reinitialize
 	if (EnemyData)
 	{
-		// Load Mesh (Synchronous load for simplicity in this phase, async is better for production)
-		if (!EnemyData->EnemyMesh.IsNull())
-		{
-			EnemyMeshComp->SetStaticMesh(EnemyData->EnemyMesh.LoadSynchronous());
-		}
-		if (!EnemyData->EnemyMaterial.IsNull())
+		if (UHordeSimulationSubsystem* HordeSim = GetWorld()->GetSubsystem<UHordeSimulationSubsystem>())
 		{
-			UMaterialInterface* BaseMaterial = EnemyData->EnemyMaterial.LoadSynchronous();
-			DynamicMaterial = UMaterialInstanceDynamic::Create(BaseMaterial, this);
-			DynamicMaterial->SetVectorParameterValue(TEXT("Color"), EnemyData->EnemyColor);
-			DynamicMaterial->SetScalarParameterValue(TEXT("EmissiveStrength"), EnemyData->EmissiveStrength);
-			DynamicMaterial->SetScalarParameterValue(TEXT("HitFlashIntensity"), 0.0f);
-			EnemyMeshComp->SetMaterial(0, DynamicMaterial);
+			HordeSim->RegisterEnemy(this);
 		}
-
-		// Apply mesh scale
-		EnemyMeshComp->SetWorldScale3D(FVector(EnemyData->MeshScale));
-
-		// Render to custom depth for post-process outline
-		EnemyMeshComp->SetRenderCustomDepth(true);
-
-		// Apply Stats
-		AttributeComp->MaxHealth.BaseValue = EnemyData->BaseHealth;
-		AttributeComp->MaxSpeed.BaseValue = EnemyData->MoveSpeed;
-		
-		// Apply Speed to Movement Component
-		GetCharacterMovement()->MaxWalkSpeed = AttributeComp->MaxSpeed.GetCurrentValue();
-		
-		// Initialize Health
-		AttributeComp->ApplyHealthChange(0); // Just to ensure clamping/init if needed, though BeginPlay of Comp handles it
 	}
 }
 
-void ASurvivorEnemy::Tick(float DeltaTime)
+void ASurvivorEnemy::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
-	Super::Tick(DeltaTime);
-
-	// Process knockback momentum and collisions
-	ProcessKnockback(DeltaTime);
-
-	// Apply crowd push velocity (from trailing enemies shoving us toward the player)
-	if (!CrowdPushVelocity.IsNearlyZero(1.0f))
-	{
-		SetActorLocation(GetActorLocation() + CrowdPushVelocity * DeltaTime);
-		float PushSpeed = CrowdPushVelocity.Size();
-		float NewPushSpeed = FMath::Max(0.f, PushSpeed - CrowdPushSettings::PushDecay * DeltaTime);
-		CrowdPushVelocity = NewPushSpeed > 1.f ? CrowdPushVelocity.GetSafeNormal() * NewPushSpeed : FVector::ZeroVector;
-	}
-
-	// --- Separation force ---
-	// Find nearby enemies and add a gentle push away from each one.
-	// Uses OverlapMultiByObjectType (Pawn object type) instead of OverlapMultiByChannel so
-	// that the query is unaffected by the capsule's ECR_Ignore response to ECC_Pawn.
-	// Channel queries respect the response matrix on both sides; object-type queries do not.
+	if (UWorld* World = GetWorld())
 	{
-		TArray<FOverlapResult> Overlaps;
-		FCollisionShape Sphere = FCollisionShape::MakeSphere(SeparationSettings::SeparationRadius);
-		FCollisionQueryParams QueryParams;
-		QueryParams.AddIgnoredActor(this);
-
-		FCollisionObjectQueryParams ObjectQueryParams;
-		ObjectQueryParams.AddObjectTypesToQuery(ECC_Pawn);
-
-		if (GetWorld()->OverlapMultiByObjectType(Overlaps, GetActorLocation(), FQuat::Identity, ObjectQueryParams, Sphere, QueryParams))
+		if (UHordeSimulationSubsystem* HordeSim = World->GetSubsystem<UHordeSimulationSubsystem>())
 		{
-			FVector SeparationInput = FVector::ZeroVector;
-
-			// Pre-compute my distance to the player (used for crowd push eligibility)
-			float MyDistToPlayer = TargetPlayer
-				? (GetActorLocation() - TargetPlayer->GetActorLocation()).Size2D()
-				: MAX_FLT;
-
-			for (const FOverlapResult& Hit : Overlaps)
-			{
-				ASurvivorEnemy* OtherEnemy = Cast<ASurvivorEnemy>(Hit.GetActor());
-				if (!OtherEnemy)
-				{
-					continue;
-				}
-
-				FVector Away = GetActorLocation() - OtherEnemy->GetActorLocation();
-				Away.Z = 0.0f;
-				float Dist = Away.Size2D();
-
-				if (Dist < KINDA_SMALL_NUMBER)
-				{
-					// Perfectly overlapping — push in a stable arbitrary direction
-					Away = FVector(1.0f, 0.0f, 0.0f);
-					Dist = 1.0f;
-				}
-
-				// Force scales linearly: strongest at dist=0, zero at SeparationRadius
-				float Strength = 1.0f - FMath::Clamp(Dist / SeparationSettings::SeparationRadius, 0.0f, 1.0f);
-
-				// Crowd push only when we're still approaching (outside orbit radius).
-				// Once at the player, everyone spreads via normal separation instead of
-				// shoving front-row enemies through the player into a blob.
-				bool bOtherIsInFront = TargetPlayer &&
-					MyDistToPlayer > OrbitSettings::OrbitRadius &&
-					(OtherEnemy->GetActorLocation() - TargetPlayer->GetActorLocation()).Size2D() < MyDistToPlayer;
-
-				if (bOtherIsInFront)
-				{
-					// Push them toward the player — trailing enemies shove the front row forward
-					FVector ToPlayerFromOther = TargetPlayer->GetActorLocation() - OtherEnemy->GetActorLocation();
-					ToPlayerFromOther.Z = 0.0f;
-					FVector PushDir = ToPlayerFromOther.GetSafeNormal();
-					OtherEnemy->AddCrowdPush(PushDir * Strength * CrowdPushSettings::MaxPushSpeed);
-				}
-				else
-				{
-					// Normal separation: push ourselves away from lateral/trailing enemies,
-					// or from any neighbor when we're already at attack range
-					SeparationInput += (Away / Dist) * Strength;
-				}
-			}
-
-			if (!SeparationInput.IsNearlyZero())
-			{
-				// Normalise direction, scale to a fixed max speed, then feed as input
-				// (AddInputVector is consumed by CharacterMovement and blended with walk speed)
-				SeparationInput = SeparationInput.GetSafeNormal()
-					* (SeparationSettings::MaxSeparationSpeed / GetCharacterMovement()->MaxWalkSpeed);
-				GetCharacterMovement()->AddInputVector(SeparationInput);
-			}
+			HordeSim->UnregisterEnemy(this);
 		}
 	}
 
-	// Simple Chase Logic
-	// We don't use AIController for thousands of units usually, but for v0.1 simple AddMovementInput is fine
-	// or SimpleMoveToActor if we had a controller.
-	// Let's use direct vector movement for "dumb" chasing which is cheap and effective for hordes.
+	Super::EndPlay(EndPlayReason);
+}
 
-	if (TargetPlayer)
+void ASurvivorEnemy::ApplyArchetype(const FEnemyArchetype& Archetype)
+{
+	// Mesh and materials were resolved once for the archetype (streamed in ahead of the unlock)
+	if (Archetype.Mesh && EnemyMeshComp->GetStaticMesh() != Archetype.Mesh)
 	{
-		FVector ToPlayer = TargetPlayer->GetActorLocation() - GetActorLocation();
-		ToPlayer.Z = 0.0f;
-		float DistToPlayer = ToPlayer.Size2D();
-
-		UCharacterMovementComponent* MoveComp = GetCharacterMovement();
-		if (MoveComp)
-		{
-			if (DistToPlayer > OrbitSettings::OrbitRadius)
-			{
-				// Outside orbit radius: chase toward player normally
-				FVector Direction = ToPlayer / DistToPlayer;
-				MoveComp->AddInputVector(Direction);
-			}
-			// Inside orbit radius: don't push further in.
-			// The separation force handles lateral positioning naturally.
-		}
+		EnemyMeshComp->SetStaticMesh(Archetype.Mesh);
+	}
 
-		// Always face the player regardless of movement
-		if (DistToPlayer > KINDA_SMALL_NUMBER)
+	// Instanced enemies are drawn by the horde's instance batch (registered with the simulation)
+	if (!bUseInstancedRendering && Archetype.SharedMaterial)
+	{
+		// One shared material per enemy type, tint baked in as parameters (no per-spawn MID);
+		// only swap when the type changed or the enemy died mid-flash
+		ArchetypeMaterial = Archetype.SharedMaterial;
+		if (EnemyMeshComp->GetMaterial(0) != ArchetypeMaterial)
 		{
-			FVector FaceDir = ToPlayer / DistToPlayer;
-			SetActorRotation(FaceDir.Rotation());
+			EnemyMeshComp->SetMaterial(0, ArchetypeMaterial);
 		}
-	}
 
-	// Decay hit flash (with hold period)
-	if (HitFlashIntensity > 0.0f)
-	{
-		if (HitFlashHoldTimer > 0.0f)
+		// Flash material: made once per enemy actor, re-made only if the base material changed
+		if (Archetype.BaseMaterial && (!HitFlashMaterial || HitFlashMaterial->Parent != Archetype.BaseMaterial))
 		{
-			// Still holding at full intensity
-			HitFlashHoldTimer -= DeltaTime;
+			HitFlashMaterial = UMaterialInstanceDynamic::Create(Archetype.BaseMaterial, this);
 		}
-		else
+		if (HitFlashMaterial)
 		{
-			// Decay after hold period
-			HitFlashIntensity = FMath::Max(0.0f, HitFlashIntensity - DeltaTime * HitFlashDecayRate);
-			if (DynamicMaterial)
-			{
-				DynamicMaterial->SetScalarParameterValue(TEXT("HitFlashIntensity"), HitFlashIntensity);
-			}
+			HitFlashMaterial->SetVectorParameterValue(TEXT("Color"), Archetype.Color);
+			HitFlashMaterial->SetScalarParameterValue(TEXT("EmissiveStrength"), Archetype.EmissiveStrength);
 		}
 	}
-}
 
-void ASurvivorEnemy::OnOverlapBegin(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
-{
-	if (OtherActor == TargetPlayer)
-	{
-		bIsOverlappingPlayer = true;
-		StartAttackTimer();
-	}
-}
+	// Apply mesh scale
+	EnemyMeshComp->SetWorldScale3D(FVector(Archetype.MeshScale));
 
-void ASurvivorEnemy::OnOverlapEnd(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex)
-{
-	if (OtherActor == TargetPlayer)
-	{
-		bIsOverlappingPlayer = false;
-		StopAttackTimer();
-	}
-}
+	// Render to custom depth for post-process outline (instance batches set this themselves)
+	EnemyMeshComp->SetVisibility(!bUseInstancedRendering);
+	EnemyMeshComp->SetRenderCustomDepth(!bUseInstancedRendering);
 
-void ASurvivorEnemy::StartAttackTimer()
-{
-	// Attack immediately then loop
-	AttackPlayer();
-	GetWorldTimerManager().SetTimer(TimerHandle_Attack, this, &ASurvivorEnemy::AttackPlayer, 1.0f, true);
-}
+	// Apply Stats
+	AttributeComp->MaxHealth.BaseValue = Archetype.MaxHealth;
+	AttributeComp->MaxSpeed.BaseValue = Archetype.MoveSpeed;
+	KnockbackMass = Archetype.KnockbackMass;
+	KnockbackResistance = Archetype.KnockbackResistance;
 
-void ASurvivorEnemy::StopAttackTimer()
-{
-	GetWorldTimerManager().ClearTimer(TimerHandle_Attack);
-}
+	// Apply Speed to Movement Component
+	GetCharacterMovement()->MaxWalkSpeed = AttributeComp->MaxSpeed.GetCurrentValue();
 
-void ASurvivorEnemy::AttackPlayer()
-{
-	if (TargetPlayer && AttributeComp && EnemyData)
-	{
-		// Apply Damage
-		// We need to access the Player's AttributeComponent
-		UAttributeComponent* PlayerAttributes = TargetPlayer->AttributeComp;
-		if (PlayerAttributes)
-		{
-			PlayerAttributes->ApplyArmoredDamage(EnemyData->BaseDamage, this);
-		}
-		else
-		{
-			UE_LOG(LogTemp, Error, TEXT("Attack Failed: Player has no AttributeComponent!"));
-		}
-	}
-	else
-	{
-		// Debug failure
-		if (!EnemyData) UE_LOG(LogTemp, Error, TEXT("Attack failed: EnemyData is NULL"));
-		if (!TargetPlayer) UE_LOG(LogTemp, Error, TEXT("Attack failed: TargetPlayer is NULL"));
-		if (!AttributeComp) UE_LOG(LogTemp, Error, TEXT("Attack failed: My AttributeComp is NULL"));
-	}
+	// Initialize Health
+	AttributeComp->ApplyHealthChange(0); // Just to ensure clamping/init if needed, though BeginPlay of Comp handles it
 }
 
 void ASurvivorEnemy::OnDeath(UAttributeComponent* Component, bool bIsResultOfEditorChange)
 {
-    // Stop attacking
-    StopAttackTimer();
-
     // Disable collision and movement
     GetCapsuleComponent()->SetCollisionEnabled(ECollisionEnabled::NoCollision);
     GetCharacterMovement()->StopMovementImmediately();
     GetCharacterMovement()->DisableMovement();
 
-    // Spawn Gems
-    if (EnemyData)
-    {
-        if (UWorld* World = GetWorld())
-        {
-            if (UXPGemSubsystem* GemSubsystem = World->GetSubsystem<UXPGemSubsystem>())
-            {
-                int32 XPToDrop = FMath::RandRange(EnemyData->MinXP, EnemyData->MaxXP);
-
-                // Greedy algorithm to find fewest gems
-                // Gem Tiers: 100, 50, 20, 5, 1
-                TArray<int32> GemTiers = {100, 50, 20, 5, 1};
-
-                for (int32 TierValue : GemTiers)
-                {
-                    while (XPToDrop >= TierValue)
-                    {
-                        // Spawn this gem
-                        FVector SpawnLoc = GetActorLocation() + FMath::VRand() * 50.0f;
-                        SpawnLoc.Z = GetActorLocation().Z; // Keep at same height roughly
-
-                        GemSubsystem->SpawnGem(SpawnLoc, TierValue);
-
-                        XPToDrop -= TierValue;
-                    }
-                }
-            }
-        }
-    }
+	// Stop simulating now (no more contact damage or drawing); the slot is compacted after the step
+	if (UHordeSimulationSubsystem* HordeSim = GetWorld()->GetSubsystem<UHordeSimulationSubsystem>())
+	{
+		HordeSim->UnregisterEnemy(this);
+	}
 
-    // Return to pool via subsystem
-    if (UWorld* World = GetWorld())
+    // Queue for the spawner's per-frame death batch (gems and pool return)
+    UEnemySpawnSubsystem* SpawnSubsystem = GetWorld()->GetSubsystem<UEnemySpawnSubsystem>();
+    if (SpawnSubsystem)
     {
-        if (UEnemySpawnSubsystem* SpawnSubsystem = World->GetSubsystem<UEnemySpawnSubsystem>())
-        {
-            SpawnSubsystem->OnEnemyDeath(this);
-            return;
-        }
+        SpawnSubsystem->OnEnemyDeath(this);
+        return;
     }
 
     // Fallback: Destroy if no subsystem (e.g., manually placed enemies)
@@ -460,252 +196,154 @@ void ASurvivorEnemy::OnHealthChanged(UAttributeComponent* Component, bool bIsRes
 {
 	float CurrentHealth = AttributeComp->GetCurrentHealth();
 
-	// Only trigger hit flash if health DECREASED (took damage)
-	if (CurrentHealth < LastKnownHealth)
+	if (UHordeSimulationSubsystem* HordeSim = GetWorld()->GetSubsystem<UHordeSimulationSubsystem>())
 	{
-		HitFlashIntensity = 1.0f;
-		HitFlashHoldTimer = HitFlashHoldDuration;
-		if (DynamicMaterial)
+		// Only trigger hit flash if health DECREASED (took damage)
+		if (CurrentHealth < LastKnownHealth)
 		{
-			DynamicMaterial->SetScalarParameterValue(TEXT("HitFlashIntensity"), HitFlashIntensity);
+			HordeSim->TriggerHitFlash(HordeIndex);
 		}
+
+		// Health bars are drawn in one pass by ASurvivorHUD from the simulation's copy
+		const float MaxHealth = AttributeComp->MaxHealth.GetCurrentValue();
+		HordeSim->SetHealthFraction(HordeIndex, MaxHealth > 0.0f ? CurrentHealth / MaxHealth : 0.0f);
 	}
 
 	// Update last known health
 	LastKnownHealth = CurrentHealth;
-
-	// Update health bar
-	if (HealthBarComp && AttributeComp)
-	{
-		UUserWidget* Widget = HealthBarComp->GetWidget();
-		if (Widget)
-		{
-			UProgressBar* ProgressBar = Cast<UProgressBar>(Widget->GetWidgetFromName(TEXT("HealthBar")));
-			if (ProgressBar)
-			{
-				float HealthPercent = AttributeComp->GetCurrentHealth() / AttributeComp->MaxHealth.GetCurrentValue();
-				ProgressBar->SetPercent(HealthPercent);
-			}
-		}
-	}
 }
 
 void ASurvivorEnemy::ApplyKnockback(FVector Impulse)
 {
-	// Add to existing knockback velocity (allows stacking)
-	KnockbackVelocity += Impulse;
-
-	// Clear hit tracking for new knockback chain
-	KnockbackHitEnemies.Empty();
-}
-
-float ASurvivorEnemy::GetKnockbackMass() const
-{
-	// Use max HP as mass proxy
-	if (AttributeComp)
+	// Knockback velocity and chain tracking live in the horde simulation
+	if (UHordeSimulationSubsystem* HordeSim = GetWorld()->GetSubsystem<UHordeSimulationSubsystem>())
 	{
-		return FMath::Max(1.0f, AttributeComp->MaxHealth.GetCurrentValue());
+		HordeSim->ApplyKnockback(HordeIndex, Impulse);
 	}
-	return 100.0f; // Default mass
 }
 
-float ASurvivorEnemy::GetKnockbackResistance() const
+void ASurvivorEnemy::SetHitFlashVisual(float Intensity)
 {
-	float MaxHP = GetKnockbackMass();
-
-	// Below light threshold: full knockback
-	if (MaxHP <= KnockbackSettings::LightEnemyHP)
+	if (!HitFlashMaterial)
 	{
-		return 1.0f;
-	}
-
-	// Above heavy threshold: minimum knockback
-	if (MaxHP >= KnockbackSettings::HeavyEnemyHP)
-	{
-		return KnockbackSettings::MinKnockbackMultiplier;
-	}
-
-	// Linear interpolation between light and heavy
-	float Alpha = (MaxHP - KnockbackSettings::LightEnemyHP) / (KnockbackSettings::HeavyEnemyHP - KnockbackSettings::LightEnemyHP);
-	return FMath::Lerp(1.0f, KnockbackSettings::MinKnockbackMultiplier, Alpha);
-}
-
-void ASurvivorEnemy::ProcessKnockback(float DeltaTime)
-{
-	// Skip if not being knocked back
-	if (KnockbackVelocity.IsNearlyZero(KnockbackSettings::MinVelocityThreshold))
-	{
-		KnockbackVelocity = FVector::ZeroVector;
-		KnockbackHitEnemies.Empty();
 		return;
 	}
 
-	// Move by knockback velocity
-	FVector Delta = KnockbackVelocity * DeltaTime;
-	FVector NewLocation = GetActorLocation() + Delta;
-	SetActorLocation(NewLocation);
-
-	// Check for collisions with other enemies
-	TArray<AActor*> OverlappingActors;
-	TArray<TEnumAsByte<EObjectTypeQuery>> ObjectTypes;
-	ObjectTypes.Add(UEngineTypes::ConvertToObjectType(ECollisionChannel::ECC_Pawn));
-
-	TArray<AActor*> IgnoreActors;
-	IgnoreActors.Add(this);
-
-	UKismetSystemLibrary::SphereOverlapActors(
-		this,
-		GetActorLocation(),
-		KnockbackSettings::CollisionCheckRadius,
-		ObjectTypes,
-		ASurvivorEnemy::StaticClass(),
-		IgnoreActors,
-		OverlappingActors
-	);
-
-	// Transfer momentum to hit enemies
-	for (AActor* Actor : OverlappingActors)
+	// Only flashing enemies wear their own material; everyone else shares the type's
+	if (Intensity > 0.0f)
 	{
-		ASurvivorEnemy* OtherEnemy = Cast<ASurvivorEnemy>(Actor);
-		if (!OtherEnemy || KnockbackHitEnemies.Contains(OtherEnemy))
-		{
-			continue;
-		}
-
-		// Mark as hit to prevent double-transfer
-		KnockbackHitEnemies.Add(OtherEnemy);
-
-		// Calculate momentum transfer based on mass
-		float MyMass = GetKnockbackMass();
-		float OtherMass = OtherEnemy->GetKnockbackMass();
-		float MassRatio = MyMass / (MyMass + OtherMass);
-
-		// Direction from me to them
-		FVector PushDir = (OtherEnemy->GetActorLocation() - GetActorLocation()).GetSafeNormal();
-		PushDir.Z = 0.0f;
-		if (PushDir.IsNearlyZero())
+		HitFlashMaterial->SetScalarParameterValue(TEXT("HitFlashIntensity"), Intensity);
+		if (EnemyMeshComp->GetMaterial(0) != HitFlashMaterial)
 		{
-			PushDir = KnockbackVelocity.GetSafeNormal();
+			EnemyMeshComp->SetMaterial(0, HitFlashMaterial);
 		}
-		PushDir.Normalize();
-
-		// Transfer momentum: heavier enemies get pushed less
-		float TransferSpeed = KnockbackVelocity.Size() * KnockbackSettings::MomentumTransferRatio * MassRatio;
-		FVector TransferVelocity = PushDir * TransferSpeed;
-
-		// Apply to the other enemy (this can chain!)
-		OtherEnemy->ApplyKnockback(TransferVelocity);
-
-		// Reduce our own velocity
-		KnockbackVelocity *= KnockbackSettings::PusherMomentumRetention;
 	}
+	else if (ArchetypeMaterial && EnemyMeshComp->GetMaterial(0) != ArchetypeMaterial)
+	{
+		EnemyMeshComp->SetMaterial(0, ArchetypeMaterial);
+	}
+}
 
-	// Apply friction deceleration
-	float Speed = KnockbackVelocity.Size();
-	float NewSpeed = FMath::Max(0.0f, Speed - KnockbackSettings::FrictionDeceleration * DeltaTime);
-
-	if (NewSpeed < KnockbackSettings::MinVelocityThreshold)
+void ASurvivorEnemy::ApplyMovementMode()
+{
+	UCharacterMovementComponent* MoveComp = GetCharacterMovement();
+	if (bUseKinematicMover)
 	{
-		KnockbackVelocity = FVector::ZeroVector;
-		KnockbackHitEnemies.Empty();
+		// CharacterMovement stays attached (its MaxWalkSpeed/MaxAcceleration are still read)
+		// but never ticks, so there is no floor finding, sweeping, or gravity
+		MoveComp->StopMovementImmediately();
+		MoveComp->DisableMovement();
+		MoveComp->SetComponentTickEnabled(false);
 	}
 	else
 	{
-		KnockbackVelocity = KnockbackVelocity.GetSafeNormal() * NewSpeed;
+		MoveComp->SetComponentTickEnabled(true);
 	}
 }
 
-void ASurvivorEnemy::AddCrowdPush(FVector Push)
-{
-	CrowdPushVelocity = (CrowdPushVelocity + Push).GetClampedToMaxSize(CrowdPushSettings::MaxPushSpeed);
-}
-
 void ASurvivorEnemy::Deactivate()
 {
+	// Stop simulating (releases our slot in the horde arrays)
+	if (UHordeSimulationSubsystem* HordeSim = GetWorld()->GetSubsystem<UHordeSimulationSubsystem>())
+	{
+		HordeSim->UnregisterEnemy(this);
+	}
+
 	// Hide and disable
 	SetActorHiddenInGame(true);
-	SetActorTickEnabled(false);
 	SetActorEnableCollision(false);
 
 	// Stop movement
 	GetCharacterMovement()->StopMovementImmediately();
 
-	// Stop attack timer
-	StopAttackTimer();
-
-	// Hide health bar
-	if (HealthBarComp)
-	{
-		HealthBarComp->SetVisibility(false);
-	}
-
 	// Reset state
-	bIsOverlappingPlayer = false;
 	TargetPlayer = nullptr;
-
-	// Reset knockback
-	KnockbackVelocity = FVector::ZeroVector;
-	KnockbackHitEnemies.Empty();
-
-	// Reset crowd push
-	CrowdPushVelocity = FVector::ZeroVector;
 }
 
-void ASurvivorEnemy::Reinitialize(UDataTable* DataTable, FName RowName, FVector Location)
+void ASurvivorEnemy::Reinitialize(int32 InArchetypeIndex, FVector Location)
 {
-	// Update data references
-	EnemyDataTable = DataTable;
-	EnemyRowName = RowName;
-
-	// Look up new row data
-	if (EnemyDataTable && !EnemyRowName.IsNone())
+	// Compiled type: no DataTable lookup on the spawn path
+	UEnemySpawnSubsystem* SpawnSubsystem = GetWorld()->GetSubsystem<UEnemySpawnSubsystem>();
+	if (SpawnSubsystem)
 	{
-		EnemyData = EnemyDataTable->FindRow<FEnemyTableRow>(EnemyRowName, TEXT("EnemyReinit"));
+		SpawnSubsystem->ResolveArchetypeAssets(InArchetypeIndex);
 	}
+	const FEnemyArchetype* Archetype = SpawnSubsystem ? SpawnSubsystem->GetArchetype(InArchetypeIndex) : nullptr;
+	ArchetypeIndex = Archetype ? InArchetypeIndex : INDEX_NONE;
+	EnemyData = Archetype ? Archetype->Row : nullptr;
+	EnemyDataTable = SpawnSubsystem ? SpawnSubsystem->EnemyDataTable : nullptr;
+	EnemyRowName = Archetype ? Archetype->RowName : NAME_None;
 
 	// Re-enable actor
 	SetActorLocation(Location);
 	SetActorHiddenInGame(false);
-	SetActorTickEnabled(true);
 	SetActorEnableCollision(true);
 
 	// Re-enable collision on capsule
 	GetCapsuleComponent()->SetCollisionEnabled(ECollisionEnabled::QueryAndPhysics);
 
-	// CRITICAL: Re-apply ECR_Ignore for ECC_Pawn after pool reactivation.
-	// SetActorEnableCollision(true) above may reset the collision profile to "Pawn" defaults
-	// which has ECR_Block for ECC_Pawn, undoing the constructor's ECR_Ignore setting.
-	GetCapsuleComponent()->SetCollisionResponseToChannel(ECC_Pawn, ECR_Ignore);
+	// CRITICAL: Re-apply the EnemyBody profile after pool reactivation.
+	// SetActorEnableCollision(true) above may restore stale responses; a body that blocks
+	// pawns or overlaps more than projectiles brings back the pairs the profile exists to avoid.
+	GetCapsuleComponent()->SetCollisionProfileName(SurvivorCollision::EnemyBodyProfile);
 
 	// Re-apply no-collision on the mesh. SetActorEnableCollision(true) restores saved
 	// component profiles, which would bring back the mesh's default blocking profile.
 	EnemyMeshComp->SetCollisionEnabled(ECollisionEnabled::NoCollision);
 
-	// Re-enable movement - force full reset of movement component state
-	// Pre-warmed enemies spawned at Z=-10000 have corrupted floor detection
-	UCharacterMovementComponent* MoveComp = GetCharacterMovement();
-	MoveComp->SetComponentTickEnabled(true);
-	MoveComp->StopMovementImmediately();
-	MoveComp->SetMovementMode(MOVE_None);  // Clear current mode
-	MoveComp->SetMovementMode(MOVE_Falling);  // Force falling to reset floor state
-	MoveComp->SetMovementMode(MOVE_Walking);  // Now set walking - will trigger floor detection
-	MoveComp->Velocity = FVector::ZeroVector;
-
-	// Force floor detection at new location
-	FFindFloorResult FloorResult;
-	MoveComp->FindFloor(GetActorLocation(), FloorResult, false);
-	if (FloorResult.bWalkableFloor)
+	// Re-enable movement. Kinematic enemies skip all of this: the horde simulation
+	// snaps them to the floor Z on register and never asks CharacterMovement again.
+	ApplyMovementMode();
+	if (!bUseKinematicMover)
 	{
-		MoveComp->SetBase(FloorResult.HitResult.GetComponent(), FloorResult.HitResult.BoneName);
+		// Force full reset of movement component state
+		// Pre-warmed enemies spawned at Z=-10000 have corrupted floor detection
+		UCharacterMovementComponent* MoveComp = GetCharacterMovement();
+		MoveComp->StopMovementImmediately();
+		MoveComp->SetMovementMode(MOVE_None);  // Clear current mode
+		MoveComp->SetMovementMode(MOVE_Falling);  // Force falling to reset floor state
+		MoveComp->SetMovementMode(MOVE_Walking);  // Now set walking - will trigger floor detection
+		MoveComp->Velocity = FVector::ZeroVector;
+
+		// Force floor detection at new location
+		FFindFloorResult FloorResult;
+		MoveComp->FindFloor(GetActorLocation(), FloorResult, false);
+		if (FloorResult.bWalkableFloor)
+		{
+			MoveComp->SetBase(FloorResult.HitResult.GetComponent(), FloorResult.HitResult.BoneName);
+		}
 	}
 
-	// Apply visuals and stats from data
-	InitializeFromData();
+	// Apply visuals and stats from the archetype
+	if (Archetype)
+	{
+		ApplyArchetype(*Archetype);
+	}
 
 	// Reset health to full
-	if (AttributeComp && EnemyData)
+	if (AttributeComp && Archetype)
 	{
-		AttributeComp->MaxHealth.BaseValue = EnemyData->BaseHealth;
+		AttributeComp->MaxHealth.BaseValue = Archetype->MaxHealth;
 		// Heal to full by applying max health as change
 		float MaxHP = AttributeComp->MaxHealth.GetCurrentValue();
 		AttributeComp->ApplyHealthChange(MaxHP);
@@ -713,26 +351,14 @@ void ASurvivorEnemy::Reinitialize(UDataTable* DataTable, FName RowName, FVector
 	}
 
 	// Reset hit flash
-	HitFlashIntensity = 0.0f;
-	HitFlashHoldTimer = 0.0f;
-	if (DynamicMaterial)
-	{
-		DynamicMaterial->SetScalarParameterValue(TEXT("HitFlashIntensity"), 0.0f);
-	}
-
-	// Show health bar
-	if (HealthBarComp)
-	{
-		HealthBarComp->SetVisibility(true);
-	}
+	SetHitFlashVisual(0.0f);
 
 	// Find player target
 	TargetPlayer = Cast<ASurvivorCharacter>(UGameplayStatics::GetPlayerCharacter(this, 0));
 
-	// Reset knockback
-	KnockbackVelocity = FVector::ZeroVector;
-	KnockbackHitEnemies.Empty();
-
-	// Reset crowd push
-	CrowdPushVelocity = FVector::ZeroVector;
+	// Start simulating with fresh motion state (knockback, crowd push, hit flash)
+	if (UHordeSimulationSubsystem* HordeSim = GetWorld()->GetSubsystem<UHordeSimulationSubsystem>())
+	{
+		HordeSim->RegisterEnemy(this);
+	}
 }
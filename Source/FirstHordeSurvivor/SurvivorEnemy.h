@@ -4,12 +4,13 @@
 #include "GameFramework/Character.h"
 #include "AttributeComponent.h"
 #include "EnemyData.h"
+#include "EnemyArchetype.h"
 #include "SurvivorEnemy.generated.h"
 
 class ASurvivorCharacter;
-class UWidgetComponent;
-class UMaterialInstanceDynamic;
 class UDataTable;
+class UMaterialInterface;
+class UMaterialInstanceDynamic;
 
 UCLASS()
 class FIRSTHORDESURVIVOR_API ASurvivorEnemy : public ACharacter
@@ -21,10 +22,9 @@ public:
 
 protected:
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
-public:	
-	virtual void Tick(float DeltaTime) override;
-
+public:
 	// Components
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
 	UAttributeComponent* AttributeComp;
@@ -32,12 +32,6 @@ public:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
 	UStaticMeshComponent* EnemyMeshComp;
 
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
-	class USphereComponent* AttackOverlapComp;
-
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
-	UWidgetComponent* HealthBarComp;
-
 	// Configuration - DataTable lookup
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Data")
 	UDataTable* EnemyDataTable;
@@ -45,78 +39,87 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Data")
 	FName EnemyRowName;
 
-	// Cached row data (set in InitializeFromData)
+	// Bypass CharacterMovement: the horde simulation moves this enemy on a flat plane at a
+	// constant floor Z with no sweeps or floor finding (walls = clamp to LevelFloor bounds).
+	// Cheaper per tick and per spawn, but the player capsule no longer blocks the enemy.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Movement")
+	bool bUseKinematicMover = false;
+
+	// Kinematic mover only: keep this enemy inside the LevelFloor bounds (KinematicMoverSettings::WallMargin
+	// from the edge) as a stand-in for wall collision. Off = free movement, e.g. for flyers or levels without walls.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Movement", meta = (EditCondition = "bUseKinematicMover"))
+	bool bClampToFloorBounds = true;
+
+	// Draw through a shared instanced mesh batch (UHordeRenderSubsystem) instead of EnemyMeshComp.
+	// The material must read color, emissive and hit flash from PerInstanceCustomData (see EnemyCustomData).
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Rendering")
+	bool bUseInstancedRendering = false;
+
+	// Compiled type in UEnemySpawnSubsystem (INDEX_NONE while pooled before first spawn)
+	int32 ArchetypeIndex = INDEX_NONE;
+
+	// Source row of the archetype (re-pointed by the spawner if the table is rebuilt)
 	const FEnemyTableRow* EnemyData = nullptr;
 
+	// Copied from the archetype on spawn
+	float KnockbackMass = 100.0f;
+	float KnockbackResistance = 1.0f;
+
 	// State
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "State")
 	ASurvivorCharacter* TargetPlayer;
 
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "State")
-	bool bIsOverlappingPlayer;
-
-	FTimerHandle TimerHandle_Attack;
-
 	// Hit flash
-	UPROPERTY()
-	UMaterialInstanceDynamic* DynamicMaterial;
-
-	float HitFlashIntensity = 0.0f;
-	float HitFlashDecayRate = 5.0f;
-	float HitFlashHoldDuration = 0.08f;  // Hold at full intensity for ~5 frames at 60fps
-	float HitFlashHoldTimer = 0.0f;
 	float LastKnownHealth = 0.0f;
 
-	// Knockback state
+	// Shared per-type material the mesh wears at rest (FEnemyArchetype::SharedMaterial)
 	UPROPERTY()
-	FVector KnockbackVelocity = FVector::ZeroVector;
+	UMaterialInterface* ArchetypeMaterial = nullptr;
 
-	// Enemies we've already transferred momentum to this knockback (prevents double-hits)
+	// Worn only while a hit flash is active. Created once per enemy actor and reused across
+	// respawns (re-tinted when the type changes), so there is no per-spawn MID.
 	UPROPERTY()
-	TSet<ASurvivorEnemy*> KnockbackHitEnemies;
+	UMaterialInstanceDynamic* HitFlashMaterial = nullptr;
 
-	// Crowd push — accumulated velocity from enemies behind pushing this one toward the player
-	FVector CrowdPushVelocity = FVector::ZeroVector;
+	// Slot in UHordeSimulationSubsystem's arrays (INDEX_NONE while pooled).
+	// Motion state (knockback, crowd push, hit flash) lives in the simulation, not on the actor.
+	int32 HordeIndex = INDEX_NONE;
 
-	// Called by a trailing enemy to push this one forward (toward the player)
-	void AddCrowdPush(FVector Push);
+	// Stable slot from UEnemySpawnSubsystem::AllocatePoolSlot (set once, survives pooling)
+	int32 PoolSlot = INDEX_NONE;
 
-	// Functions
-	UFUNCTION()
-	void OnOverlapBegin(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult);
+	// Position in UEnemySpawnSubsystem's packed active array (INDEX_NONE while pooled)
+	int32 ActiveIndex = INDEX_NONE;
 
-	UFUNCTION()
-	void OnOverlapEnd(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex);
+	// Push the current hit flash intensity to the mesh material (called by the horde simulation).
+	// Swaps to HitFlashMaterial while the flash is on and back to the shared material once it reaches 0.
+	void SetHitFlashVisual(float Intensity);
 
+	// Functions
     UFUNCTION()
     void OnDeath(UAttributeComponent* Component, bool bIsResultOfEditorChange);
 
 	UFUNCTION()
 	void OnHealthChanged(UAttributeComponent* Component, bool bIsResultOfEditorChange);
 
-	void AttackPlayer();
-	void StartAttackTimer();
-	void StopAttackTimer();
-
-	// Helper to apply stats from DataTable row
-	void InitializeFromData();
+	// Apply precomputed visuals and stats of a compiled enemy type
+	void ApplyArchetype(const FEnemyArchetype& Archetype);
 
 	// Knockback system - applies impulse and handles momentum transfer on collision
 	UFUNCTION(BlueprintCallable, Category = "Combat")
 	void ApplyKnockback(FVector Impulse);
 
 	// Get mass for knockback calculations (uses MaxHealth as proxy)
-	float GetKnockbackMass() const;
+	float GetKnockbackMass() const { return KnockbackMass; }
 
 	// Get knockback multiplier based on HP (lighter enemies get knocked back more)
 	// Returns 1.0 for light enemies, scales down to minimum for heavy enemies
-	float GetKnockbackResistance() const;
+	float GetKnockbackResistance() const { return KnockbackResistance; }
+
+	// Turn CharacterMovement ticking on/off to match bUseKinematicMover
+	void ApplyMovementMode();
 
 	// Pooling support
 	void Deactivate();
-	void Reinitialize(UDataTable* DataTable, FName RowName, FVector Location);
-
-protected:
-	// Process knockback movement and collisions
-	void ProcessKnockback(float DeltaTime);
+	void Reinitialize(int32 InArchetypeIndex, FVector Location);
 };
@@ -2,9 +2,12 @@
 #include "XPGemSubsystem.h"
 #include "XPGemVisualConfig.h"
 #include "UpgradeSubsystem.h"
+#include "SurvivorHUD.h"
 
 ASurvivorGameMode::ASurvivorGameMode()
 {
+	// Draws enemy health bars in one batched canvas pass
+	HUDClass = ASurvivorHUD::StaticClass();
 }
 
 void ASurvivorGameMode::BeginPlay()
@@ -0,0 +1,47 @@
+#include "SurvivorHUD.h"
+#include "Engine/Canvas.h"
+#include "Engine/World.h"
+
+void ASurvivorHUD::DrawHUD()
+{
+	Super::DrawHUD();
+
+	if (bDrawEnemyHealthBars)
+	{
+		DrawEnemyHealthBars();
+	}
+}
+
+void ASurvivorHUD::DrawEnemyHealthBars()
+{
+	UHordeSimulationSubsystem* HordeSim = GetWorld()->GetSubsystem<UHordeSimulationSubsystem>();
+	if (!HordeSim || !Canvas)
+	{
+		return;
+	}
+
+	HealthBars.Reset();
+	HordeSim->GetVisibleHealthBars(HealthBarHeightOffset, HealthBars);
+
+	// Every bar is two untextured tiles, which the canvas batches into one draw
+	const float Width = HealthBarSize.X;
+	const float Height = HealthBarSize.Y;
+	for (const FHordeHealthBar& Bar : HealthBars)
+	{
+		const FVector Screen = Project(Bar.WorldPosition, true);
+		if (Screen.Z <= 0.0f)
+		{
+			continue;  // Behind the camera
+		}
+
+		const float Left = Screen.X - Width * 0.5f;
+		const float Top = Screen.Y - Height * 0.5f;
+		if (Left + Width < 0.0f || Top + Height < 0.0f || Left > Canvas->ClipX || Top > Canvas->ClipY)
+		{
+			continue;
+		}
+
+		DrawRect(HealthBarBackgroundColor, Left, Top, Width, Height);
+		DrawRect(HealthBarFillColor, Left, Top, Width * Bar.HealthFraction, Height);
+	}
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/HUD.h"
+#include "HordeSimulationSubsystem.h"
+#include "SurvivorHUD.generated.h"
+
+/**
+ * HUD for First Horde Survivor.
+ * Draws every damaged, on-screen enemy's health bar in one canvas pass,
+ * fed by UHordeSimulationSubsystem::GetVisibleHealthBars (no per-enemy widgets).
+ */
+UCLASS()
+class FIRSTHORDESURVIVOR_API ASurvivorHUD : public AHUD
+{
+	GENERATED_BODY()
+
+public:
+	virtual void DrawHUD() override;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Enemy Health Bars")
+	bool bDrawEnemyHealthBars = true;
+
+	// Bar size in canvas pixels
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Enemy Health Bars")
+	FVector2D HealthBarSize = FVector2D(100.0f, 10.0f);
+
+	// World-space height of the bar above the enemy's origin
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Enemy Health Bars")
+	float HealthBarHeightOffset = 120.0f;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Enemy Health Bars")
+	FLinearColor HealthBarBackgroundColor = FLinearColor(0.0f, 0.0f, 0.0f, 0.6f);
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Enemy Health Bars")
+	FLinearColor HealthBarFillColor = FLinearColor(0.85f, 0.1f, 0.1f, 1.0f);
+
+protected:
+	void DrawEnemyHealthBars();
+
+	// Reused every frame
+	TArray<FHordeHealthBar> HealthBars;
+};
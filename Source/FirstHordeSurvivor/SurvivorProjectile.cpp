@@ -3,19 +3,22 @@
 #include "Components/SphereComponent.h"
 #include "NiagaraComponent.h"
 #include "Kismet/GameplayStatics.h"
-#include "Kismet/KismetSystemLibrary.h"
 #include "AttributeComponent.h"
 #include "NiagaraFunctionLibrary.h"
 #include "GameFramework/Character.h"
 #include "GameFramework/CharacterMovementComponent.h"
 #include "SurvivorEnemy.h"
+#include "SurvivorCollision.h"
+#include "EnemySpawnSubsystem.h"
+#include "ProjectilePoolSubsystem.h"
+#include "ProjectileSimulationSubsystem.h"
 
 ASurvivorProjectile::ASurvivorProjectile()
 {
 	PrimaryActorTick.bCanEverTick = true;
 
 	SphereComp = CreateDefaultSubobject<USphereComponent>(TEXT("SphereComp"));
-	SphereComp->SetCollisionProfileName("OverlapAllDynamic");
+	SphereComp->SetCollisionProfileName(SurvivorCollision::PlayerProjectileProfile); // Overlaps enemy bodies and walls
 	SphereComp->SetGenerateOverlapEvents(false); // Re-enabled in BeginPlay to prevent overlap during construction
 	RootComponent = SphereComp;
 
@@ -43,18 +46,77 @@ void ASurvivorProjectile::BeginPlay()
 {
 	Super::BeginPlay();
 	StartLocation = GetActorLocation();
-	// Defer enabling overlaps to next tick so SpawnActor has returned before any overlap fires.
+	DeferEnableOverlaps();
+}
+
+float ASurvivorProjectile::GetCollisionRadius() const
+{
+	return SphereComp ? SphereComp->GetUnscaledSphereRadius() * SphereComp->GetRelativeScale3D().GetMax() : 0.0f;
+}
+
+void ASurvivorProjectile::DeferEnableOverlaps()
+{
+	// Defer enabling overlaps to next tick so SpawnActor/AcquireProjectile has returned before any overlap fires.
 	// Enabling overlaps immediately in BeginPlay (which runs inside SpawnActor) can trigger
-	// OnOverlapBegin → Destroy() before SpawnActor returns, causing it to return null.
-	GetWorld()->GetTimerManager().SetTimerForNextTick([this]()
+	// OnOverlapBegin → ReturnToPool() before the weapon has initialized us.
+	SphereComp->SetGenerateOverlapEvents(false);
+	const uint32 Activation = ++ActivationCount;
+	TWeakObjectPtr<ASurvivorProjectile> WeakThis(this);
+	GetWorld()->GetTimerManager().SetTimerForNextTick([WeakThis, Activation]()
 	{
-		if (IsValid(this) && SphereComp)
+		ASurvivorProjectile* Projectile = WeakThis.Get();
+		if (Projectile && !Projectile->bInPool && Projectile->ActivationCount == Activation)
 		{
-			SphereComp->SetGenerateOverlapEvents(true);
+			Projectile->SphereComp->SetGenerateOverlapEvents(true);
 		}
 	});
 }
 
+void ASurvivorProjectile::Activate(const FTransform& Transform, APawn* InInstigator)
+{
+	bInPool = false;
+	SetActorTransform(Transform, false, nullptr, ETeleportType::ResetPhysics);
+	SetInstigator(InInstigator);
+	SetActorHiddenInGame(false);
+	SetActorEnableCollision(true);
+	SetActorTickEnabled(true);
+
+	MovementComp->SetUpdatedComponent(SphereComp);
+	MovementComp->SetComponentTickEnabled(true);
+	TrailComp->Activate(true);
+
+	StartLocation = Transform.GetLocation();
+	DeferEnableOverlaps();
+}
+
+void ASurvivorProjectile::Deactivate()
+{
+	bInPool = true;
+	SetActorHiddenInGame(true);
+	SetActorTickEnabled(false);
+	SphereComp->SetGenerateOverlapEvents(false);
+	SetActorEnableCollision(false);
+
+	MovementComp->StopMovementImmediately();
+	MovementComp->SetComponentTickEnabled(false);
+	TrailComp->DeactivateImmediate();
+
+	HitEnemies.Reset();
+	RemainingPierces = 0;
+}
+
+void ASurvivorProjectile::ReturnToPool()
+{
+	if (UProjectilePoolSubsystem* Pool = GetWorld()->GetSubsystem<UProjectilePoolSubsystem>())
+	{
+		Pool->ReleaseProjectile(this);
+	}
+	else
+	{
+		Destroy();
+	}
+}
+
 void ASurvivorProjectile::Initialize(
 	float Speed,
 	float DamageAmount,
@@ -77,9 +139,11 @@ void ASurvivorProjectile::Initialize(
 	AoERadius = ExplosionRadius;
 	Knockback = KnockbackForce;
 
-	// DataAsset impact effects override Blueprint defaults if provided
-	if (InImpactSound) { HitSound = InImpactSound; }
-	if (InImpactVFX) { HitVFX = InImpactVFX; }
+	// DataAsset impact effects override Blueprint defaults if provided (a pooled projectile
+	// may still hold another weapon's override, so fall back to the class default explicitly)
+	const ASurvivorProjectile* Defaults = GetClass()->GetDefaultObject<ASurvivorProjectile>();
+	HitSound = InImpactSound ? InImpactSound : Defaults->HitSound;
+	HitVFX = InImpactVFX ? InImpactVFX : Defaults->HitVFX;
 
 	ExplosionSound = InExplosionSound;
 	ExplosionVFX = InExplosionVFX;
@@ -89,6 +153,11 @@ void ASurvivorProjectile::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
 
+	if (bInPool)
+	{
+		return;
+	}
+
 	// Range Check
 	if (FVector::DistSquared(GetActorLocation(), StartLocation) > MaxRange * MaxRange)
 	{
@@ -97,33 +166,40 @@ void ASurvivorProjectile::Tick(float DeltaTime)
 		{
 			Explode();
 		}
-		Destroy();
+		ReturnToPool();
 	}
 }
 
 void ASurvivorProjectile::OnOverlapBegin(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
 {
-	if (!OtherActor || OtherActor == GetInstigator())
+	// Several overlaps can be dispatched from one move; ignore the rest once we're pooled
+	if (bInPool || !OtherActor || OtherActor == GetInstigator())
 	{
 		return;
 	}
 
 	// Skip already-hit enemies (for piercing projectiles)
-	if (HitEnemies.Contains(OtherActor))
+	ASurvivorEnemy* Enemy = Cast<ASurvivorEnemy>(OtherActor);
+	UEnemySpawnSubsystem* SpawnSubsystem = GetWorld()->GetSubsystem<UEnemySpawnSubsystem>();
+	const FEnemyHandle Handle = SpawnSubsystem ? SpawnSubsystem->GetEnemyHandle(Enemy) : FEnemyHandle();
+	if (Handle.IsSet() && HitEnemies.Contains(Handle))
 	{
 		return;
 	}
 
-	// Check if it's a damageable target
-	UAttributeComponent* AttrComp = Cast<UAttributeComponent>(OtherActor->GetComponentByClass(UAttributeComponent::StaticClass()));
+	// Check if it's a damageable target (enemies carry their component; only other actors pay for a lookup)
+	UAttributeComponent* AttrComp = Enemy ? Enemy->AttributeComp : OtherActor->FindComponentByClass<UAttributeComponent>();
 
 	if (AttrComp)
 	{
 		// Track that we directly hit this enemy (prevents re-hitting same enemy)
-		HitEnemies.Add(OtherActor);
+		if (Handle.IsSet())
+		{
+			HitEnemies.Add(Handle);
+		}
 
 		// Apply damage and knockback to the directly-hit enemy
-		DamageTarget(OtherActor);
+		DamageTarget(OtherActor, AttrComp);
 
 		// Effects based on whether this is an explosive or single-target projectile
 		if (AoERadius > 0.0f)
@@ -151,8 +227,8 @@ void ASurvivorProjectile::OnOverlapBegin(UPrimitiveComponent* OverlappedComponen
 		}
 		else
 		{
-			// No more pierces, destroy
-			Destroy();
+			// No more pierces, back to the pool
+			ReturnToPool();
 		}
 	}
 	else if (OtherActor->ActorHasTag("WorldStatic"))
@@ -162,18 +238,17 @@ void ASurvivorProjectile::OnOverlapBegin(UPrimitiveComponent* OverlappedComponen
 		{
 			Explode();
 		}
-		Destroy();
+		ReturnToPool();
 	}
 }
 
-void ASurvivorProjectile::DamageTarget(AActor* Target)
+void ASurvivorProjectile::DamageTarget(AActor* Target, UAttributeComponent* AttrComp)
 {
 	if (!Target)
 	{
 		return;
 	}
 
-	UAttributeComponent* AttrComp = Cast<UAttributeComponent>(Target->GetComponentByClass(UAttributeComponent::StaticClass()));
 	if (AttrComp)
 	{
 		AttrComp->ApplyHealthChange(-Damage);
@@ -195,35 +270,13 @@ void ASurvivorProjectile::Explode(AActor* DirectHitActor)
 		UNiagaraFunctionLibrary::SpawnSystemAtLocation(this, ExplosionVFX, GetActorLocation());
 	}
 
-	// Find all actors in explosion radius
-	TArray<AActor*> OverlappingActors;
-	TArray<TEnumAsByte<EObjectTypeQuery>> ObjectTypes;
-	ObjectTypes.Add(UEngineTypes::ConvertToObjectType(ECollisionChannel::ECC_Pawn));
-
-	UKismetSystemLibrary::SphereOverlapActors(
-		this,
-		GetActorLocation(),
-		AoERadius,
-		ObjectTypes,
-		nullptr, // Actor class filter
-		TArray<AActor*>(), // Ignore actors
-		OverlappingActors
-	);
-
-	// Damage all enemies in radius EXCEPT:
-	// - The instigator (player)
-	// - The directly-hit enemy who triggered this explosion (already damaged by DamageTarget)
-	// Previously-hit enemies CAN be damaged by this explosion, allowing for stacking AoE damage
-	for (AActor* Actor : OverlappingActors)
-	{
-		if (Actor && Actor != GetInstigator() && Actor != DirectHitActor)
-		{
-			UAttributeComponent* AttrComp = Cast<UAttributeComponent>(Actor->GetComponentByClass(UAttributeComponent::StaticClass()));
-			if (AttrComp)
-			{
-				DamageTarget(Actor);
-			}
-		}
+	// Damage all enemies in radius EXCEPT the directly-hit enemy who triggered this explosion
+	// (already damaged by DamageTarget). Previously-hit enemies CAN be damaged by this explosion,
+	// allowing for stacking AoE damage. Resolved against the enemy spatial grid with one batched
+	// damage call, shared with the actorless projectile simulation.
+	if (UProjectileSimulationSubsystem* ProjectileSim = GetWorld()->GetSubsystem<UProjectileSimulationSubsystem>())
+	{
+		ProjectileSim->ApplyExplosionDamage(GetActorLocation(), AoERadius, Damage, Knockback, Cast<ASurvivorEnemy>(DirectHitActor));
 	}
 }
 
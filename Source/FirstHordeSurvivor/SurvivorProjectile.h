@@ -2,12 +2,14 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
+#include "EnemyHandle.h"
 #include "SurvivorProjectile.generated.h"
 
 class USphereComponent;
 class UProjectileMovementComponent;
 class UNiagaraComponent;
 class UNiagaraSystem;
+class UAttributeComponent;
 
 UCLASS()
 class FIRSTHORDESURVIVOR_API ASurvivorProjectile : public AActor
@@ -47,6 +49,18 @@ public:
 		UNiagaraSystem* InExplosionVFX = nullptr
 	);
 
+	// Pooling (UProjectilePoolSubsystem). Activate re-arms a pooled projectile at Transform;
+	// Initialize is called after it as for a freshly spawned one.
+	void Activate(const FTransform& Transform, APawn* InInstigator);
+	void Deactivate();
+	bool IsInPool() const { return bInPool; }
+
+	// Read from the class default object by UProjectileSimulationSubsystem
+	UStaticMeshComponent* GetMeshComponent() const { return MeshComp; }
+	float GetCollisionRadius() const;
+	USoundBase* GetHitSound() const { return HitSound; }
+	UNiagaraSystem* GetHitVFX() const { return HitVFX; }
+
 protected:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
 	USphereComponent* SphereComp;
@@ -75,9 +89,15 @@ protected:
 	// Knockback force
 	float Knockback;
 
-	// Track hit enemies to avoid double-hits during pierce
-	UPROPERTY()
-	TSet<AActor*> HitEnemies;
+	// Track hit enemies to avoid double-hits during pierce. Handles, not actor pointers:
+	// an enemy that dies and is recycled from the pool mid-flight counts as a new target.
+	TSet<FEnemyHandle> HitEnemies;
+
+	// Parked in UProjectilePoolSubsystem (hidden, no collision, no movement)
+	bool bInPool = false;
+
+	// Bumped on every activation so a stale deferred overlap enable is ignored
+	uint32 ActivationCount = 0;
 
 	// ===== Visuals =====
 
@@ -96,11 +116,17 @@ protected:
 
 	// ===== Internal Functions =====
 
+	// Turn overlaps on next tick, once the spawner has finished setting us up
+	void DeferEnableOverlaps();
+
+	// Back to the projectile pool (replaces Destroy)
+	void ReturnToPool();
+
 	UFUNCTION()
 	void OnOverlapBegin(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult);
 
-	/** Apply damage to a single target with knockback. */
-	void DamageTarget(AActor* Target);
+	/** Apply damage to a single target with knockback. AttrComp is the target's (looked up once by the caller). */
+	void DamageTarget(AActor* Target, UAttributeComponent* AttrComp);
 
 	/** Trigger explosion, damaging all enemies in radius except the direct-hit actor. */
 	void Explode(AActor* DirectHitActor = nullptr);
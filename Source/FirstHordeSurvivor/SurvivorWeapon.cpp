@@ -4,6 +4,9 @@
 #include "SurvivorProjectile.h"
 #include "Kismet/GameplayStatics.h"
 #include "SurvivorEnemy.h"
+#include "TargetingSubsystem.h"
+#include "ProjectilePoolSubsystem.h"
+#include "ProjectileSimulationSubsystem.h"
 #include "NiagaraFunctionLibrary.h"
 #include "DrawDebugHelpers.h"
 
@@ -24,6 +27,14 @@ void ASurvivorWeapon::BeginPlay()
 
 void ASurvivorWeapon::StartShooting()
 {
+	// Size the shared projectile pool for this weapon (actor projectiles only)
+	UProjectileWeaponData* ProjData = GetProjectileData();
+	UProjectilePoolSubsystem* ProjectilePool = GetWorld()->GetSubsystem<UProjectilePoolSubsystem>();
+	if (ProjData && ProjData->bUseProjectileActors && ProjData->ProjectileClass && ProjectilePool)
+	{
+		ProjectilePool->SetPoolSize(ProjData->ProjectileClass, ProjData->ProjectilePoolSize);
+	}
+
 	float RPM = GetEffectiveRPM();
 	if (RPM > 0.0f)
 	{
@@ -127,6 +138,12 @@ void ASurvivorWeapon::Fire()
 		return;
 	}
 
+	// Let the other weapons spread onto different enemies
+	if (UTargetingSubsystem* Targeting = GetWorld()->GetSubsystem<UTargetingSubsystem>())
+	{
+		Targeting->ClaimTarget(Cast<ASurvivorEnemy>(Target), this);
+	}
+
 	// Cache spawn info
 	BurstSpawnLocation = GetOwner() ? GetOwner()->GetActorLocation() : GetActorLocation();
 	FVector Direction = (Target->GetActorLocation() - BurstSpawnLocation).GetSafeNormal();
@@ -224,16 +241,38 @@ void ASurvivorWeapon::FireSingleProjectile(int32 ProjectileIndex, int32 TotalPro
 	// Spawn at current owner location (not cached location)
 	// This allows barrage projectiles to follow the player while maintaining direction
 	FVector SpawnLocation = GetOwner() ? GetOwner()->GetActorLocation() : GetActorLocation();
-	FTransform SpawnTM(Rot, SpawnLocation);
 
-	FActorSpawnParameters SpawnParams;
-	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
-	SpawnParams.Instigator = Cast<APawn>(GetOwner());
+	// Actorless by default: one struct in the batched projectile simulation
+	UProjectileSimulationSubsystem* ProjectileSim = GetWorld()->GetSubsystem<UProjectileSimulationSubsystem>();
+	if (!ProjData->bUseProjectileActors && ProjectileSim)
+	{
+		ProjectileSim->LaunchProjectile(
+			ProjData->ProjectileClass,
+			SpawnLocation,
+			FinalDir,
+			GetStat(EWeaponStat::ProjectileSpeed),
+			GetStat(EWeaponStat::Damage),
+			GetStat(EWeaponStat::Range),
+			FMath::RoundToInt(GetStat(EWeaponStat::Penetration)),
+			GetStat(EWeaponStat::Area),
+			GetStat(EWeaponStat::Knockback),
+			ProjData->ImpactSound,
+			ProjData->ImpactVFX,
+			ProjData->ExplosionSound,
+			ProjData->ExplosionVFX
+		);
+		return;
+	}
+
+	FTransform SpawnTM(Rot, SpawnLocation);
 
-	ASurvivorProjectile* Proj = GetWorld()->SpawnActor<ASurvivorProjectile>(ProjData->ProjectileClass, SpawnTM, SpawnParams);
+	UProjectilePoolSubsystem* ProjectilePool = GetWorld()->GetSubsystem<UProjectilePoolSubsystem>();
+	ASurvivorProjectile* Proj = ProjectilePool
+		? ProjectilePool->AcquireProjectile(ProjData->ProjectileClass, SpawnTM, Cast<APawn>(GetOwner()))
+		: nullptr;
 	if (!Proj)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("ASurvivorWeapon::SpawnProjectile — SpawnActor returned null! "
+		UE_LOG(LogTemp, Warning, TEXT("ASurvivorWeapon::SpawnProjectile — AcquireProjectile returned null! "
 			"WeaponID='%s'  ProjectileClass='%s'  SpawnLocation=(%.1f, %.1f, %.1f)"),
 			*ProjData->WeaponID.ToString(),
 			*ProjData->ProjectileClass->GetName(),
@@ -306,70 +345,62 @@ void ASurvivorWeapon::ScheduleNextAttack()
 
 AActor* ASurvivorWeapon::FindBestTarget()
 {
-	UProjectileWeaponData* ProjData = GetProjectileData();
-	if (!ProjData)
-	{
-		return nullptr;
-	}
-
-	TArray<AActor*> Enemies;
-	UGameplayStatics::GetAllActorsOfClass(this, ASurvivorEnemy::StaticClass(), Enemies);
-
-	if (Enemies.Num() == 0)
-	{
-		return nullptr;
-	}
-
-	AActor* BestTarget = nullptr;
-	float BestScore = -FLT_MAX;
+	return FindBestTargets(1, TargetScratch) > 0 ? TargetScratch[0] : nullptr;
+}
 
-	// Use owner's location (the player) rather than weapon's own location
-	FVector MyLoc = GetOwner() ? GetOwner()->GetActorLocation() : GetActorLocation();
-	FVector MyVelocity = FVector::ZeroVector;
+int32 ASurvivorWeapon::FindBestTargets(int32 MaxTargets, TArray<ASurvivorEnemy*>& OutTargets)
+{
+	OutTargets.Reset();
 
-	// Get Owner Velocity for "InFront" calculation
-	if (AActor* OwnerActor = GetOwner())
+	UProjectileWeaponData* ProjData = GetProjectileData();
+	UTargetingSubsystem* Targeting = GetWorld()->GetSubsystem<UTargetingSubsystem>();
+	if (!ProjData || !Targeting || MaxTargets <= 0)
 	{
-		MyVelocity = OwnerActor->GetVelocity();
+		return 0;
 	}
 
-	// Normalize velocity for Dot Product
-	FVector MoveDir = MyVelocity.GetSafeNormal();
-	bool bIsMoving = !MyVelocity.IsNearlyZero();
-
+	// Shared per-frame list around the owner (the player): distance and facing dot already computed
 	float MaxRange = GetStat(EWeaponStat::Range);
+	const AActor* Origin = GetOwner() ? GetOwner() : this;
 
-	for (AActor* Enemy : Enemies)
+	// Score with this weapon's weights; keep the best K sorted
+	ScoredTargets.Reset();
+	for (const FTargetCandidate& Candidate : Targeting->GetCandidates(Origin, MaxRange))
 	{
-		float DistSq = FVector::DistSquared(MyLoc, Enemy->GetActorLocation());
-		float Dist = FMath::Sqrt(DistSq);
-
-		// Max Range Check
-		if (Dist > MaxRange)
+		// Max Range Check (the list may have been built for a longer-range weapon)
+		if (Candidate.Distance > MaxRange || Candidate.Enemy->ActiveIndex == INDEX_NONE)
 		{
 			continue;
 		}
 
 		// Calculate Score
-		float RangeScore = Dist * ProjData->RangeWeight;
-		float InFrontScore = 0.0f;
-
-		// InFront Score
-		if (bIsMoving)
+		float RangeScore = Candidate.Distance * ProjData->RangeWeight;
+		float InFrontScore = Candidate.FacingDot * ProjData->InFrontWeight;
+		float SpreadPenalty = ProjData->TargetSpreadPenalty > 0.0f
+			? Targeting->GetClaimCount(Candidate, this) * ProjData->TargetSpreadPenalty
+			: 0.0f;
+
+		const float TotalScore = RangeScore + InFrontScore - SpreadPenalty;
+		if (ScoredTargets.Num() == MaxTargets)
 		{
-			FVector DirToEnemy = (Enemy->GetActorLocation() - MyLoc).GetSafeNormal();
-			float Dot = FVector::DotProduct(MoveDir, DirToEnemy);
-			InFrontScore = Dot * ProjData->InFrontWeight;
+			if (TotalScore <= ScoredTargets.Last().Score)
+			{
+				continue;
+			}
+			ScoredTargets.Pop(EAllowShrinking::No);
 		}
 
-		float TotalScore = RangeScore + InFrontScore;
-
-		if (TotalScore > BestScore)
+		int32 Insert = ScoredTargets.Num();
+		while (Insert > 0 && ScoredTargets[Insert - 1].Score < TotalScore)
 		{
-			BestScore = TotalScore;
-			BestTarget = Enemy;
+			--Insert;
 		}
+		ScoredTargets.Insert({ TotalScore, Candidate.Enemy }, Insert);
 	}
 
-	return BestTarget;
+	for (const FScoredTarget& Target : ScoredTargets)
+	{
+		OutTargets.Add(Target.Enemy);
+	}
+	return OutTargets.Num();
 }
@@ -8,6 +8,7 @@
 
 class UWeaponDataBase;
 class UProjectileWeaponData;
+class ASurvivorEnemy;
 
 UCLASS()
 class FIRSTHORDESURVIVOR_API ASurvivorWeapon : public AActor
@@ -72,6 +73,18 @@ protected:
 	void Fire();
 	AActor* FindBestTarget();
 
+	// Up to MaxTargets active enemies within Range, best score first (scored from the shared UTargetingSubsystem list)
+	int32 FindBestTargets(int32 MaxTargets, TArray<ASurvivorEnemy*>& OutTargets);
+
+	// Scratch for target queries, reused between shots
+	struct FScoredTarget
+	{
+		float Score;
+		ASurvivorEnemy* Enemy;
+	};
+	TArray<FScoredTarget> ScoredTargets;
+	TArray<ASurvivorEnemy*> TargetScratch;
+
 	// Helper to get projectile data (returns nullptr if not a projectile weapon)
 	UProjectileWeaponData* GetProjectileData() const;
 
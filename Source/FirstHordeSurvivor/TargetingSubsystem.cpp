@@ -0,0 +1,147 @@
+#include "TargetingSubsystem.h"
+#include "EnemySpatialGridSubsystem.h"
+#include "EnemySpawnSubsystem.h"
+#include "SurvivorEnemy.h"
+#include "Engine/World.h"
+
+void UTargetingSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	SpatialGrid = Collection.InitializeDependency<UEnemySpatialGridSubsystem>();
+	SpawnSubsystem = Collection.InitializeDependency<UEnemySpawnSubsystem>();
+}
+
+void UTargetingSubsystem::Deinitialize()
+{
+	Candidates.Empty();
+	Claims.Empty();
+	SlotClaimGenerations.Empty();
+	SlotClaimCounts.Empty();
+	SpatialGrid = nullptr;
+	SpawnSubsystem = nullptr;
+
+	Super::Deinitialize();
+}
+
+bool UTargetingSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	// Only create for game worlds, not editor preview
+	UWorld* World = Cast<UWorld>(Outer);
+	return World && World->IsGameWorld();
+}
+
+TConstArrayView<FTargetCandidate> UTargetingSubsystem::GetCandidates(const AActor* Origin, float Range)
+{
+	// Already built this frame around the same origin, wide enough
+	if (CandidateFrame == GFrameCounter && CandidateOrigin == Origin && CandidateRange >= Range)
+	{
+		return Candidates;
+	}
+
+	CandidateFrame = GFrameCounter;
+	CandidateOrigin = Origin;
+	CandidateRange = Range;
+	Candidates.Reset();
+
+	if (!Origin || !SpatialGrid || !SpawnSubsystem)
+	{
+		return Candidates;
+	}
+
+	const FVector Velocity = Origin->GetVelocity();
+	const FVector2f MoveDir = FVector2f((float)Velocity.X, (float)Velocity.Y).GetSafeNormal();
+	const bool bIsMoving = !Velocity.IsNearlyZero();
+	const FVector2f Center = UEnemySpatialGridSubsystem::ToGridPosition(Origin->GetActorLocation());
+
+	SpatialGrid->ForEachInRadius(Center, Range, [&](int32 ItemIndex, const FVector2f& ItemPosition, float DistSq)
+	{
+		// Grid is built at the start of the horde step; skip anyone who died (or was recycled) since
+		ASurvivorEnemy* Enemy = SpatialGrid->GetEnemy(ItemIndex);
+		const FEnemyHandle Handle = SpatialGrid->GetHandle(ItemIndex);
+		if (!Handle.IsSet() || SpawnSubsystem->GetEnemyHandle(Enemy) != Handle)
+		{
+			return;
+		}
+
+		const float Distance = FMath::Sqrt(DistSq);
+		const float FacingDot = bIsMoving && Distance > UE_KINDA_SMALL_NUMBER
+			? FVector2f::DotProduct(MoveDir, (ItemPosition - Center) / Distance)
+			: 0.0f;
+		Candidates.Add({ Enemy, Handle, Distance, FacingDot });
+	});
+
+	ExpireClaims();
+	return Candidates;
+}
+
+int32 UTargetingSubsystem::GetClaimCount(const FTargetCandidate& Candidate, const UObject* IgnoreClaimant) const
+{
+	const int32 Slot = Candidate.Handle.Index;
+	if (!SlotClaimCounts.IsValidIndex(Slot) || SlotClaimGenerations[Slot] != Candidate.Handle.Generation)
+	{
+		return 0;
+	}
+
+	int32 Count = SlotClaimCounts[Slot];
+
+	// Only claimed enemies pay for the scan, and there are few live claims
+	if (Count > 0 && IgnoreClaimant)
+	{
+		for (const FTargetClaim& Claim : Claims)
+		{
+			if (Claim.Claimant == IgnoreClaimant && Claim.Handle == Candidate.Handle)
+			{
+				Count--;
+			}
+		}
+	}
+	return FMath::Max(0, Count);
+}
+
+void UTargetingSubsystem::ClaimTarget(const ASurvivorEnemy* Enemy, const UObject* Claimant)
+{
+	if (!SpawnSubsystem || ClaimDuration <= 0.0f)
+	{
+		return;
+	}
+
+	const FEnemyHandle Handle = SpawnSubsystem->GetEnemyHandle(Enemy);
+	if (!Handle.IsSet())
+	{
+		return;
+	}
+
+	if (Handle.Index >= SlotClaimCounts.Num())
+	{
+		SlotClaimCounts.SetNumZeroed(Handle.Index + 1);
+		SlotClaimGenerations.SetNumZeroed(Handle.Index + 1);
+	}
+
+	// Claims left over from the slot's previous occupant don't count
+	if (SlotClaimGenerations[Handle.Index] != Handle.Generation)
+	{
+		SlotClaimGenerations[Handle.Index] = Handle.Generation;
+		SlotClaimCounts[Handle.Index] = 0;
+	}
+	SlotClaimCounts[Handle.Index]++;
+
+	Claims.Add({ Handle, Claimant, GetWorld()->GetTimeSeconds() });
+}
+
+void UTargetingSubsystem::ExpireClaims()
+{
+	// Every claim is measured against the same (current) duration, so they expire in insertion order
+	const float ExpireBefore = GetWorld()->GetTimeSeconds() - ClaimDuration;
+	int32 NumExpired = 0;
+	while (NumExpired < Claims.Num() && Claims[NumExpired].ClaimTime <= ExpireBefore)
+	{
+		const FEnemyHandle Handle = Claims[NumExpired].Handle;
+		if (SlotClaimGenerations[Handle.Index] == Handle.Generation)
+		{
+			SlotClaimCounts[Handle.Index] = FMath::Max(0, SlotClaimCounts[Handle.Index] - 1);
+		}
+		NumExpired++;
+	}
+	Claims.RemoveAt(0, NumExpired, EAllowShrinking::No);
+}
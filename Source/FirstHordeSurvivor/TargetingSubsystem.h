@@ -0,0 +1,84 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "EnemyHandle.h"
+#include "TargetingSubsystem.generated.h"
+
+class ASurvivorEnemy;
+class UEnemySpatialGridSubsystem;
+class UEnemySpawnSubsystem;
+
+// One enemy near the player with the weight-independent terms of the weapon score
+struct FTargetCandidate
+{
+	ASurvivorEnemy* Enemy;
+	FEnemyHandle Handle;
+	float Distance;   // Flat (XY) distance from the player
+	float FacingDot;  // Dot(player move direction, direction to enemy); 0 while standing still
+};
+
+/**
+ * WorldSubsystem shared by every weapon the player owns.
+ *
+ * The first weapon to ask in a frame builds the candidate list (one spatial grid query
+ * around the player, distance and facing precomputed); every other weapon that frame
+ * scores the same list with its own RangeWeight/InFrontWeight.
+ *
+ * Weapons claim the enemy they fire at. Claims last ClaimDuration seconds and are counted
+ * per enemy, so a weapon's TargetSpreadPenalty steers it off targets others already took
+ * (its own claims don't count). Counts are indexed by pool slot and tagged with the handle
+ * generation: O(1) for unclaimed enemies, and a claim never carries over to whoever reuses the slot.
+ */
+UCLASS()
+class FIRSTHORDESURVIVOR_API UTargetingSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// USubsystem interface
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+
+	// Active enemies within at least Range of Origin, built at most once per frame
+	// (rebuilt if a later caller needs a larger range). Callers filter by their own Range.
+	TConstArrayView<FTargetCandidate> GetCandidates(const AActor* Origin, float Range);
+
+	// Live claims on this candidate, not counting the ones made by IgnoreClaimant (the asking weapon)
+	int32 GetClaimCount(const FTargetCandidate& Candidate, const UObject* IgnoreClaimant = nullptr) const;
+
+	// Record that Claimant (a weapon) just fired at Enemy (expires after ClaimDuration)
+	void ClaimTarget(const ASurvivorEnemy* Enemy, const UObject* Claimant);
+
+	UPROPERTY(EditAnywhere, Category = "Targeting", meta = (ClampMin = "0.0"))
+	float ClaimDuration = 0.5f;  // Roughly a projectile's flight time to mid range
+
+protected:
+	void ExpireClaims();
+
+	UPROPERTY()
+	UEnemySpatialGridSubsystem* SpatialGrid;
+
+	UPROPERTY()
+	UEnemySpawnSubsystem* SpawnSubsystem;
+
+	TArray<FTargetCandidate> Candidates;
+	const AActor* CandidateOrigin = nullptr;
+	uint64 CandidateFrame = MAX_uint64;
+	float CandidateRange = 0.0f;
+
+	// Live claims, oldest first. Expiry is ClaimTime + the current ClaimDuration, so the
+	// order holds even if ClaimDuration is edited at runtime.
+	struct FTargetClaim
+	{
+		FEnemyHandle Handle;
+		const UObject* Claimant;  // Identity only, never dereferenced
+		float ClaimTime;
+	};
+	TArray<FTargetClaim> Claims;
+
+	// Indexed by pool slot; a count only applies while its generation matches the enemy's
+	TArray<uint32> SlotClaimGenerations;
+	TArray<int32> SlotClaimCounts;
+};
@@ -6,6 +6,7 @@
 #include "Materials/MaterialInstanceDynamic.h"
 #include "XPGemSubsystem.h"
 #include "SurvivorCharacter.h"
+#include "SurvivorCollision.h"
 
 AXPGem::AXPGem()
 {
@@ -13,7 +14,7 @@ AXPGem::AXPGem()
 
 	MeshComp = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("MeshComp"));
 	RootComponent = MeshComp;
-	MeshComp->SetCollisionProfileName(TEXT("NoCollision")); // We handle pickup via distance check in Tick or Player
+	MeshComp->SetCollisionProfileName(SurvivorCollision::PickupProfile); // No collision: we handle pickup via distance check in Tick or Player
 
 	TrailComp = CreateDefaultSubobject<UNiagaraComponent>(TEXT("TrailComp"));
 	TrailComp->SetupAttachment(RootComponent);
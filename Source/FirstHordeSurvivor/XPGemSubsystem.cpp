@@ -107,6 +107,42 @@ void UXPGemSubsystem::Deinitialize()
 }
 
 void UXPGemSubsystem::SpawnGem(FVector Location, int32 Value)
+{
+    const FGemSpawnRequest Request{ Location, Value };
+    SpawnGems(MakeArrayView(&Request, 1));
+}
+
+void UXPGemSubsystem::SpawnGems(TConstArrayView<FGemSpawnRequest> Requests)
+{
+    // Only a handful of distinct gem values exist (GemSettings::Tiers)
+    TArray<TPair<int32, FXPGemData>, TInlineAllocator<8>> Visuals;
+
+    for (const FGemSpawnRequest& Request : Requests)
+    {
+        const FXPGemData* VisualData = nullptr;
+        for (const TPair<int32, FXPGemData>& Entry : Visuals)
+        {
+            if (Entry.Key == Request.Value)
+            {
+                VisualData = &Entry.Value;
+                break;
+            }
+        }
+        if (!VisualData)
+        {
+            // Apply visuals (DataAsset if available, otherwise code defaults)
+            VisualData = &Visuals.Emplace_GetRef(Request.Value, GetVisualDataForValue(Request.Value)).Value;
+        }
+
+        if (AXPGem* Gem = AcquireGem(Request.Location))
+        {
+            Gem->Initialize(Request.Value, Request.Location);
+            Gem->SetVisuals(*VisualData);
+        }
+    }
+}
+
+AXPGem* UXPGemSubsystem::AcquireGem(const FVector& Location)
 {
     AXPGem* GemToSpawn = nullptr;
 
@@ -160,14 +196,7 @@ void UXPGemSubsystem::SpawnGem(FVector Location, int32 Value)
         }
     }
 
-    if (GemToSpawn)
-    {
-        GemToSpawn->Initialize(Value, Location);
-
-        // Apply visuals (DataAsset if available, otherwise code defaults)
-        FXPGemData VisualData = GetVisualDataForValue(Value);
-        GemToSpawn->SetVisuals(VisualData);
-    }
+    return GemToSpawn;
 }
 
 void UXPGemSubsystem::ReturnGem(AXPGem* Gem)
@@ -7,6 +7,13 @@
 
 class UXPGemVisualConfig;
 
+// One gem for UXPGemSubsystem::SpawnGems
+struct FGemSpawnRequest
+{
+    FVector Location;
+    int32 Value;
+};
+
 /**
  * Subsystem to manage XP Gem pooling and spawning
  */
@@ -23,6 +30,10 @@ public:
     UFUNCTION(BlueprintCallable, Category = "XP Gems")
     void SpawnGem(FVector Location, int32 Value);
 
+    // Spawns many gems at once (e.g. a frame's worth of enemy deaths).
+    // Visual data is looked up once per distinct value instead of once per gem.
+    void SpawnGems(TConstArrayView<FGemSpawnRequest> Requests);
+
     // Returns a gem to the pool
     void ReturnGem(AXPGem* Gem);
 
@@ -41,6 +52,9 @@ protected:
     // Creates hardcoded default visuals (fallback when no DataAsset configured)
     void InitializeDefaultVisuals();
 
+    // Pop a pooled gem or spawn a new one
+    AXPGem* AcquireGem(const FVector& Location);
+
     // The pool of inactive gems
     UPROPERTY()
     TArray<AXPGem*> GemPool;